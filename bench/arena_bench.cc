@@ -0,0 +1,124 @@
+/**
+ * @file arena_bench.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <benchmark/benchmark.h>
+
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/food.h"
+#include "src/robot.h"
+
+/*******************************************************************************
+ * Benchmarks
+ ******************************************************************************/
+// The collision test between a robot and a food, which overlap
+static void BM_ArenaIsColliding(benchmark::State &state) {
+  csci3081::arena_params params;
+  params.seed = 1;
+  csci3081::Arena arena(&params);
+  csci3081::Robot robot;
+  robot.set_position(300, 300);
+  csci3081::Food food;
+  food.set_position(310, 310);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(arena.IsColliding(&robot, &food));
+  }
+}
+BENCHMARK(BM_ArenaIsColliding);
+
+// Pushing a robot out of a food it overlaps
+static void BM_ArenaAdjustEntityOverlap(benchmark::State &state) {
+  csci3081::arena_params params;
+  params.seed = 1;
+  csci3081::Arena arena(&params);
+  csci3081::Robot robot;
+  csci3081::Food food;
+  food.set_position(310, 310);
+  for (auto _ : state) {
+    robot.set_position(300, 300);
+    arena.AdjustEntityOverlap(&robot, &food);
+    benchmark::DoNotOptimize(robot.get_pose());
+  }
+}
+BENCHMARK(BM_ArenaAdjustEntityOverlap);
+
+/*
+ * A full timestep of an arena of state.range(0) robots, state.range(1)
+ * lights and state.range(2) food, in sensing mode state.range(3). The arena is
+ * reconfigured, outside of the timing, whenever its game is over so that
+ * every timed step does the work of a running game.
+ */
+static void BM_ArenaTimestep(benchmark::State &state) {
+  csci3081::arena_params params;
+  params.n_robots = static_cast<size_t>(state.range(0));
+  params.n_lights = static_cast<size_t>(state.range(1));
+  params.n_food = static_cast<size_t>(state.range(2));
+  params.sensing_mode = static_cast<csci3081::SensingMode>(state.range(3));
+  params.seed = 1;
+  csci3081::Arena arena(&params);
+  for (auto _ : state) {
+    if (arena.get_game_status() != PLAYING) {
+      state.PauseTiming();
+      arena.Reconfigure(&params);
+      state.ResumeTiming();
+    }
+    arena.UpdateEntitiesTimestep();
+  }
+
+  double n_entities = static_cast<double>(
+    params.n_robots + params.n_lights + params.n_food);
+  state.counters["ticks_per_second"] = benchmark::Counter(
+    static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+  state.counters["time_per_entity"] = benchmark::Counter(n_entities,
+    benchmark::Counter::kIsIterationInvariantRate |
+    benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_ArenaTimestep)
+  ->ArgNames({"robots", "lights", "food", "sensing"})
+  ->Args({10, 4, 4, csci3081::kSenseAll})
+  ->Args({100, 10, 10, csci3081::kSenseAll})
+  ->Args({1000, 40, 40, csci3081::kSenseAll})
+  ->Args({1000, 200, 200, csci3081::kSenseAll})
+  ->Args({1000, 200, 200, csci3081::kSenseCutoff})
+  ->Args({1000, 200, 200, csci3081::kSenseField});
+
+/*
+ * Getting a new arena of state.range(0) robots, 10 lights and 10 food, as a
+ * sweep worker does between runs, alternating between two seeds and sizes:
+ * by deleting the last one and building another when state.range(1) is 0,
+ * by reconfiguring it in place when it is 1.
+ */
+static void BM_ArenaRebuild(benchmark::State &state) {
+  csci3081::arena_params params[2];
+  for (int k = 0; k < 2; k++) {
+    params[k].n_robots = static_cast<size_t>(state.range(0)) / (k + 1);
+    params[k].n_lights = 10;
+    params[k].n_food = 10;
+    params[k].seed = static_cast<uint32_t>(k + 1);
+  }
+  bool in_place = (state.range(1) != 0);
+  auto *arena = new csci3081::Arena(&params[0]);
+  int next = 1;
+  for (auto _ : state) {
+    if (in_place) {
+      arena->Reconfigure(&params[next]);
+    } else {
+      delete arena;
+      arena = new csci3081::Arena(&params[next]);
+    }
+    next = 1 - next;
+  }
+  delete arena;
+}
+BENCHMARK(BM_ArenaRebuild)
+  ->ArgNames({"robots", "in_place"})
+  ->Args({100, 0})
+  ->Args({100, 1})
+  ->Args({1000, 0})
+  ->Args({1000, 1});
@@ -0,0 +1,138 @@
+/**
+ * @file motion_bench.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <vector>
+
+#include "src/differential_drive_kernel.h"
+#include "src/motion_behavior_differential.h"
+#include "src/motion_handler_explore.h"
+#include "src/motion_handler_fear.h"
+#include "src/robot.h"
+#include "src/robot_policy.h"
+#include "src/wheel_velocity.h"
+#include "src/wiring.h"
+
+/*******************************************************************************
+ * Benchmarks
+ ******************************************************************************/
+// One differential drive step of a robot turning in an arc
+static void BM_DifferentialUpdatePose(benchmark::State &state) {
+  csci3081::Robot robot;
+  robot.set_position(500, 400);
+  csci3081::MotionBehaviorDifferential behavior(&robot);
+  csci3081::WheelVelocity velocity(4, 5);
+  for (auto _ : state) {
+    behavior.UpdatePose(1, velocity);
+    // keep the robot near its start so the pose stays in range
+    robot.set_position(500, 400);
+    benchmark::DoNotOptimize(robot.get_pose());
+  }
+}
+BENCHMARK(BM_DifferentialUpdatePose);
+
+// One differential drive step of a batch of entities, half of them turning
+static void BM_IntegrateDifferentialDrive(benchmark::State &state) {
+  size_t n = static_cast<size_t>(state.range(0));
+  std::vector<double> left(n, 4), right(n), x(n), y(n), theta(n);
+  for (size_t i = 0; i < n; i++) {
+    right[i] = (i % 2) ? 5 : 4;
+  }
+  for (auto _ : state) {
+    std::fill(x.begin(), x.end(), 500);
+    std::fill(y.begin(), y.end(), 400);
+    csci3081::IntegrateDifferentialDrive(n, 1, left.data(), right.data(),
+      x.data(), y.data(), theta.data());
+    benchmark::DoNotOptimize(x.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+BENCHMARK(BM_IntegrateDifferentialDrive)->Arg(1)->Arg(64)->Arg(1024);
+
+// The fear controller, once not hungry and once aggressive
+static void BM_FearUpdateVelocity(benchmark::State &state) {
+  csci3081::Robot robot;
+  csci3081::MotionHandlerFear handler(&robot);
+  int hungry_level = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    handler.UpdateVelocity(120, 80, 40, 60, hungry_level, true);
+    benchmark::DoNotOptimize(handler.get_velocity());
+  }
+}
+BENCHMARK(BM_FearUpdateVelocity)->Arg(0)->Arg(HUNGRY);
+
+// The explore controller, once not hungry and once aggressive
+static void BM_ExploreUpdateVelocity(benchmark::State &state) {
+  csci3081::Robot robot;
+  csci3081::MotionHandlerExplore handler(&robot);
+  int hungry_level = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    handler.UpdateVelocity(120, 80, 40, 60, hungry_level, true);
+    benchmark::DoNotOptimize(handler.get_velocity());
+  }
+}
+BENCHMARK(BM_ExploreUpdateVelocity)->Arg(0)->Arg(HUNGRY);
+
+// The batched controller of a group of hungry fear robots
+static void BM_FearControllerKernel(benchmark::State &state) {
+  size_t n = static_cast<size_t>(state.range(0));
+  std::vector<double> light_left(n), light_right(n), food_left(n),
+    food_right(n), max_speed(n, ROBOT_MAX_SPEED), left(n), right(n);
+  for (size_t i = 0; i < n; i++) {
+    light_left[i] = static_cast<double>(i % 1000);
+    light_right[i] = static_cast<double>((i * 7) % 1000);
+    food_left[i] = static_cast<double>((i * 3) % 1000);
+    food_right[i] = static_cast<double>((i * 5) % 1000);
+  }
+  csci3081::controller_batch batch;
+  batch.light_left = light_left.data();
+  batch.light_right = light_right.data();
+  batch.food_left = food_left.data();
+  batch.food_right = food_right.data();
+  batch.max_speed = max_speed.data();
+  batch.vel_left = left.data();
+  batch.vel_right = right.data();
+  csci3081::ControllerKernel kernel =
+    csci3081::ControllerKernelFor(csci3081::kFear, csci3081::kHungry);
+  for (auto _ : state) {
+    kernel(n, batch);
+    benchmark::DoNotOptimize(left.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+BENCHMARK(BM_FearControllerKernel)->Arg(1024)->Arg(100000);
+
+// The wiring matrices of a batch of robots, each with its own weights
+static void BM_ApplyWirings(benchmark::State &state) {
+  size_t n = static_cast<size_t>(state.range(0));
+  std::vector<double> weights(csci3081::kWiringWeightCount * n),
+    light_left(n), light_right(n), food_left(n), food_right(n),
+    max_speed(n, ROBOT_MAX_SPEED), left(n), right(n);
+  csci3081::vehicle_wiring wiring =
+    csci3081::DefaultWiring(csci3081::kExplorer);
+  for (size_t i = 0; i < n; i++) {
+    for (size_t w = 0; w < csci3081::kWiringWeightCount; w++) {
+      weights[w * n + i] = wiring.band[i % csci3081::kHungerBandCount]
+        .weight[w];
+    }
+    light_left[i] = static_cast<double>(i % 1000);
+    light_right[i] = static_cast<double>((i * 7) % 1000);
+    food_left[i] = static_cast<double>((i * 3) % 1000);
+    food_right[i] = static_cast<double>((i * 5) % 1000);
+  }
+  for (auto _ : state) {
+    csci3081::ApplyWirings(n, weights.data(), light_left.data(),
+      light_right.data(), food_left.data(), food_right.data(),
+      max_speed.data(), left.data(), right.data());
+    benchmark::DoNotOptimize(left.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+BENCHMARK(BM_ApplyWirings)->Arg(1024)->Arg(100000);
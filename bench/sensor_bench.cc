@@ -0,0 +1,110 @@
+/**
+ * @file sensor_bench.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "src/food_sensor.h"
+#include "src/light_sensing_kernel.h"
+#include "src/light_sensor.h"
+#include "src/pose.h"
+#include "src/response_table.h"
+
+/*******************************************************************************
+ * Benchmarks
+ ******************************************************************************/
+// One light sensor reading the contribution of one light
+static void BM_LightSensorReading(benchmark::State &state) {
+  csci3081::LightSensor sensor;
+  sensor.set_sensitivity(1.081);
+  csci3081::Pose light(400, 300);
+  csci3081::Pose position(120, 80);
+  for (auto _ : state) {
+    sensor.zero_reading();
+    sensor.CalculateSensorReading(light, 30, position);
+    benchmark::DoNotOptimize(sensor.get_reading());
+  }
+}
+BENCHMARK(BM_LightSensorReading);
+
+// One food sensor reading the contribution of one food
+static void BM_FoodSensorReading(benchmark::State &state) {
+  csci3081::FoodSensor sensor;
+  csci3081::Pose food(400, 300);
+  csci3081::Pose position(120, 80);
+  for (auto _ : state) {
+    sensor.zero_reading();
+    sensor.CalculateSensorReading(food, 20, position);
+    benchmark::DoNotOptimize(sensor.get_reading());
+  }
+}
+BENCHMARK(BM_FoodSensorReading);
+
+// The batched kernel, for state.range(0) sensors and state.range(1) lights
+static void BM_LightSensingKernel(benchmark::State &state) {
+  size_t n_sensors = static_cast<size_t>(state.range(0));
+  size_t n_lights = static_cast<size_t>(state.range(1));
+  std::vector<double> sensor_x(n_sensors), sensor_y(n_sensors);
+  std::vector<double> sensitivity(n_sensors, 1.081);
+  std::vector<double> readings(n_sensors);
+  for (size_t i = 0; i < n_sensors; i++) {
+    sensor_x[i] = static_cast<double>((i * 137) % 1000);
+    sensor_y[i] = static_cast<double>((i * 251) % 700);
+  }
+  std::vector<double> light_x(n_lights), light_y(n_lights);
+  std::vector<double> light_radius(n_lights, 30);
+  for (size_t j = 0; j < n_lights; j++) {
+    light_x[j] = static_cast<double>((j * 311) % 1000);
+    light_y[j] = static_cast<double>((j * 173) % 700);
+  }
+  for (auto _ : state) {
+    csci3081::AccumulateLightReadings(n_sensors, sensor_x.data(),
+      sensor_y.data(), sensitivity.data(), n_lights, light_x.data(),
+      light_y.data(), light_radius.data(), 1e9, readings.data());
+    benchmark::DoNotOptimize(readings.data());
+    benchmark::ClobberMemory();
+  }
+  state.counters["time_per_pair"] = benchmark::Counter(
+    static_cast<double>(n_sensors * n_lights),
+    benchmark::Counter::kIsIterationInvariantRate |
+    benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_LightSensingKernel)->Args({20, 4})->Args({2000, 100});
+
+// The same, with the responses interpolated in a table
+static void BM_ResponseTableSensing(benchmark::State &state) {
+  size_t n_sensors = static_cast<size_t>(state.range(0));
+  size_t n_lights = static_cast<size_t>(state.range(1));
+  std::vector<double> sensor_x(n_sensors), sensor_y(n_sensors);
+  std::vector<double> readings(n_sensors);
+  for (size_t i = 0; i < n_sensors; i++) {
+    sensor_x[i] = static_cast<double>((i * 137) % 1000);
+    sensor_y[i] = static_cast<double>((i * 251) % 700);
+  }
+  std::vector<double> light_x(n_lights), light_y(n_lights);
+  std::vector<double> light_radius(n_lights, 30);
+  for (size_t j = 0; j < n_lights; j++) {
+    light_x[j] = static_cast<double>((j * 311) % 1000);
+    light_y[j] = static_cast<double>((j * 173) % 700);
+  }
+  csci3081::ResponseTable table;
+  table.Build(1.081, 1300);
+  for (auto _ : state) {
+    csci3081::AccumulateTableReadings(table, n_sensors, sensor_x.data(),
+      sensor_y.data(), n_lights, light_x.data(), light_y.data(),
+      light_radius.data(), 1e9, readings.data());
+    benchmark::DoNotOptimize(readings.data());
+    benchmark::ClobberMemory();
+  }
+  state.counters["time_per_pair"] = benchmark::Counter(
+    static_cast<double>(n_sensors * n_lights),
+    benchmark::Counter::kIsIterationInvariantRate |
+    benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_ResponseTableSensing)->Args({20, 4})->Args({2000, 100});
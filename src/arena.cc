@@ -8,50 +8,196 @@
  * Includes
  ******************************************************************************/
 #include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
 
 #include "src/arena.h"
 #include "src/arena_params.h"
+#include "src/binary_io.h"
+#include "src/differential_drive_kernel.h"
+#include "src/light_sensing_kernel.h"
+#include "src/trajectory_recorder.h"
 
 /*******************************************************************************
  * Namespaces
  ******************************************************************************/
 NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+static const char CHECKPOINT_MAGIC[4] = {'B', 'V', 'C', 'K'};
+static const uint32_t CHECKPOINT_VERSION = 6;
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/* Shared by the entity based and the store based collision checks, so that
+ * both give exactly the same result.
+ */
+static bool CirclesOverlap(double mobile_x, double mobile_y,
+  double mobile_radius, double other_x, double other_y, double other_radius) {
+  double delta_x = other_x - mobile_x;
+  double delta_y = other_y - mobile_y;
+  double distance_between = sqrt(delta_x*delta_x + delta_y*delta_y);
+  return (distance_between <= (mobile_radius + other_radius));
+}
+
+static void PushOutOfCircle(double *mobile_x, double *mobile_y,
+  double mobile_radius, double other_x, double other_y, double other_radius) {
+  double delta_x = *mobile_x - other_x;
+  double delta_y = *mobile_y - other_y;
+  double distance_between = sqrt(delta_x*delta_x + delta_y*delta_y);
+  double distance_to_move = mobile_radius + other_radius
+  - distance_between + 5;
+  double angle = atan2(delta_y, delta_x);
+  *mobile_x = *mobile_x+cos(angle)*distance_to_move;
+  *mobile_y = *mobile_y+sin(angle)*distance_to_move;
+}
+
+static EntityType WallAt(double x, double y, double radius, double x_dim,
+  double y_dim) {
+  if (x + radius >= x_dim) {
+    return kRightWall;  // at x = x_dim_
+  } else if (x - radius <= 0) {
+    return kLeftWall;  // at x = 0
+  } else if (y + radius >= y_dim) {
+    return kBottomWall;  // at y = y_dim
+  } else if (y - radius <= 0) {
+    return kTopWall;  // at y = 0
+  } else {
+    return kUndefined;
+  }
+}
+
+static void PushOffWall(double *x, double *y, double radius, double x_dim,
+  double y_dim, EntityType wall) {
+  switch (wall) {
+    case (kRightWall):  // at x = x_dim_
+    *x = x_dim-(radius+5);
+    break;
+    case (kLeftWall):  // at x = 0
+    *x = radius+5;
+    break;
+    case (kTopWall):  // at y = 0
+    *y = radius+5;
+    break;
+    case (kBottomWall):  // at y = y_dim_
+    *y = y_dim-(radius+5);
+    break;
+    default:
+    {}
+  }
+}
+
 /*******************************************************************************
  * Constructors/Destructor
  ******************************************************************************/
 Arena::Arena(const struct arena_params *const params)
-    : x_dim_(params->x_dim),
+    : params_(*params),
+      x_dim_(params->x_dim),
       y_dim_(params->y_dim),
-      factory_(new EntityFactory),
+      rng_(params->seed != 0 ? params->seed : std::random_device{}()),
+      factory_(new EntityFactory(&rng_)),
+      robot_(),
+      light_(),
       entities_(),
       mobile_entities_(),
+      food_(),
+      store_(),
+      collision_mode_(params->collision_mode),
+      collision_grid_(),
+      light_table_(),
+      food_table_(),
+      food_signature_(),
+      light_grid_(),
+      food_grid_(),
+      light_field_(),
+      food_field_(),
+      thread_pool_(params->n_threads),
+      scratch_(thread_pool_.get_n_threads()),
+      profiler_(),
+      own_draw_snapshot_(),
+      draw_snapshot_(&own_draw_snapshot_),
+      draw_label_(),
+      draw_labels_(),
       game_status_(PLAYING),
       game_paused_(false),
       food_off_(false) {
-
-  robot_count_ = params->n_robots;
-  AddRobot(params->n_robots, params->n_ratio, params->n_light_sensitivity,
-  params->food_on);
-
-  AddLights(params->n_lights);
-
-  if (params->food_on) {
-    AddFood(params->n_food);
-  } else {
-    food_off_ = true;
-  }
+  params_.seed = static_cast<uint32_t>(rng_.get_seed());
+  AddEntities();
+  RebuildDrawLabels();
+  PublishDrawSnapshot();
 }
 
 Arena::~Arena() {
-  for (auto ent : entities_) {
-    delete ent;
-  } /* for(ent..) */
+  // The factory owns the entities.
+  delete factory_;
 }
 
 /*******************************************************************************
  * Member Functions
  ******************************************************************************/
+void Arena::AddEntities() {
+  robot_count_ = params_.n_robots;
+  AddRobot(params_.n_robots, params_.n_ratio, params_.n_light_sensitivity,
+  params_.food_on);
+
+  AddLights(params_.n_lights);
+
+  if (params_.food_on) {
+    AddFood(params_.n_food);
+  } else {
+    food_off_ = true;
+  }
+
+  BindEntityStore();
+  set_sensing_mode(params_.sensing_mode, params_.sensing_epsilon);
+  set_response_mode(params_.response_mode);
+} /* AddEntities() */
+
+void Arena::Reconfigure(const struct arena_params *const params) {
+  // Destroyed last to first, so that the pools hand their slots out again
+  // in the order the entities were created in.
+  for (auto ent = entities_.rbegin(); ent != entities_.rend(); ++ent) {
+    factory_->DestroyEntity(*ent);
+  }
+  robot_.clear();
+  light_.clear();
+  entities_.clear();
+  mobile_entities_.clear();
+  food_.clear();
+  factory_->Reset();
+
+  size_t n_threads = params_.n_threads;
+  params_ = *params;
+  params_.n_threads = n_threads;
+  x_dim_ = params->x_dim;
+  y_dim_ = params->y_dim;
+  rng_ = Rng(params->seed != 0 ? params->seed : std::random_device{}());
+  params_.seed = static_cast<uint32_t>(rng_.get_seed());
+  epoch_ = 0;
+  collision_mode_ = params->collision_mode;
+  if (collision_grid_.get_cols() > 0) {
+    // Only rebuilt on a change of cell size, so fit it to the new dimensions
+    collision_grid_.Resize(x_dim_, y_dim_, collision_grid_.get_cell_size());
+  }
+  food_signature_.clear();
+  game_status_ = PLAYING;
+  game_paused_ = false;
+  food_off_ = false;
+
+  AddEntities();
+  // A smaller arena leaves the end of the pools empty
+  factory_->Shrink();
+  RebuildDrawLabels();
+  PublishDrawSnapshot();
+} /* Reconfigure() */
+
 void Arena::AddRobot(int quantity, int ratio, int light_sense, bool food_on) {
   //  Create Robots, every robot's type and motion handler type are originnally
   //  declared as Coward /Fear.
@@ -59,17 +205,21 @@ void Arena::AddRobot(int quantity, int ratio, int light_sense, bool food_on) {
   double quant = static_cast<double>(quantity)*rate;
   quant = static_cast<int>(quant);
   double sense = 1.001 + static_cast<double>(light_sense)/1000;
+  light_sensitivity_ = sense;
 
 
+  size_t first = robot_.size();
+  robot_.reserve(first + quantity);
   for (int i = 0; i < quantity; i++) {
-    robot_[i] = dynamic_cast<Robot *>(factory_->CreateEntity(kRobot));
-    robot_[i]->set_light_sensitivity(sense);
-    entities_.push_back(robot_[i]);
-    mobile_entities_.push_back(robot_[i]);
-    robot_[i]->set_food_existence(food_on);
+    Robot *robot = dynamic_cast<Robot *>(factory_->CreateEntity(kRobot));
+    robot->set_light_sensitivity(sense);
+    entities_.push_back(robot);
+    mobile_entities_.push_back(robot);
+    robot->set_food_existence(food_on);
+    robot_.push_back(robot);
   }
 
-  for (int j = quant; j < quantity; j++) {
+  for (size_t j = first + quant; j < robot_.size(); j++) {
     robot_[j]->set_robot_type(kExplorer);
     //  Change motion handler to MotionHandlerExplore
     robot_[j]->ChangeToExplore();
@@ -78,144 +228,914 @@ void Arena::AddRobot(int quantity, int ratio, int light_sense, bool food_on) {
 
 void Arena::AddFood(int quantity) {
   for (int i = 0; i < quantity; i++) {
-    entities_.push_back(factory_->CreateEntity(kFood));
+    food_.push_back(dynamic_cast<Food *>(factory_->CreateEntity(kFood)));
+    entities_.push_back(food_.back());
   }
 }
 
 void Arena::AddLights(int quantity) {
+light_count_ = quantity;
+light_.reserve(light_.size() + quantity);
 for (int i = 0; i < quantity; i++) {
-  light_[i] = dynamic_cast<Light *>(factory_->CreateEntity(kLight));
-  entities_.push_back(light_[i]);
-  mobile_entities_.push_back(light_[i]);
+  light_.push_back(dynamic_cast<Light *>(factory_->CreateEntity(kLight)));
+  entities_.push_back(light_.back());
+  mobile_entities_.push_back(light_.back());
 }
 }
 
+void Arena::set_sensing_mode(SensingMode mode, double epsilon) {
+  sensing_mode_ = mode;
+  params_.sensing_mode = mode;
+  params_.sensing_epsilon = epsilon;
+  if (kSenseAll != mode) {
+    light_cutoff_ = Sensor::CutoffDistance(light_sensitivity_, epsilon);
+    food_cutoff_ = Sensor::CutoffDistance(FOOD_SENSITIVITY, epsilon);
+    if (params_.food_sensing_radius > 0) {
+      food_cutoff_ = std::min(food_cutoff_, params_.food_sensing_radius);
+    }
+  } else {
+    light_cutoff_ = std::numeric_limits<double>::infinity();
+    food_cutoff_ = std::numeric_limits<double>::infinity();
+  }
+  for (int i = 0; i < robot_count_; i++) {
+    robot_[i]->set_sensing_cutoff(light_cutoff_, food_cutoff_);
+  }
+  if (kSenseCutoff == mode) {
+    // Cells no larger than the arena, but at least as large as the cutoff
+    // so that most queries only touch a few cells.
+    light_grid_.Resize(x_dim_, y_dim_,
+      std::min(light_cutoff_, std::max(x_dim_, y_dim_)));
+    food_grid_.Resize(x_dim_, y_dim_,
+      std::min(food_cutoff_, std::max(x_dim_, y_dim_)));
+  } else {
+    if (kSenseField == mode) {
+      light_field_.Resize(x_dim_, y_dim_, params_.field_cell_size);
+      light_field_.set_response(light_sensitivity_, light_cutoff_);
+      food_field_.Resize(x_dim_, y_dim_, params_.field_cell_size);
+      food_field_.set_response(FOOD_SENSITIVITY, food_cutoff_);
+    }
+    // Only used to find the food a robot can eat
+    food_grid_.Resize(x_dim_, y_dim_, 5 + ROBOT_RADIUS + FOOD_RADIUS);
+  }
+  InvalidateFoodReadings();
+} /* set_sensing_mode() */
+
+void Arena::set_response_mode(ResponseMode mode) {
+  params_.response_mode = mode;
+  if (kResponseTable == mode) {
+    // No sensor is further than this from the edge of a source
+    double max_distance = std::hypot(x_dim_, y_dim_);
+    light_table_.Build(light_sensitivity_, max_distance);
+    food_table_.Build(FOOD_SENSITIVITY, max_distance);
+  }
+  InvalidateFoodReadings();
+} /* set_response_mode() */
+
+void Arena::set_food_sensing_threshold(double threshold) {
+  params_.food_sensing_threshold = threshold;
+  InvalidateFoodReadings();
+} /* set_food_sensing_threshold() */
+
+bool Arena::SaveCheckpoint(std::ostream &out) const {
+  out.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+  WriteValue(out, CHECKPOINT_VERSION);
+  WriteValue(out, static_cast<uint32_t>(params_.x_dim));
+  WriteValue(out, static_cast<uint32_t>(params_.y_dim));
+  WriteValue(out, static_cast<uint64_t>(params_.n_robots));
+  WriteValue(out, static_cast<uint64_t>(params_.n_lights));
+  WriteValue(out, static_cast<uint64_t>(params_.n_food));
+  WriteValue(out, static_cast<uint64_t>(params_.n_light_sensitivity));
+  WriteValue(out, static_cast<uint64_t>(params_.n_ratio));
+  WriteValue(out, static_cast<uint8_t>(params_.food_on));
+  WriteValue(out, static_cast<int32_t>(collision_mode_));
+  WriteValue(out, static_cast<int32_t>(params_.sensing_mode));
+  WriteValue(out, params_.sensing_epsilon);
+  WriteValue(out, params_.food_sensing_radius);
+  WriteValue(out, static_cast<int32_t>(params_.response_mode));
+  WriteValue(out, params_.field_cell_size);
+  WriteValue(out, params_.food_sensing_threshold);
+  WriteValue(out, params_.seed);
+  WriteValue(out, static_cast<int32_t>(params_.controller_mode));
+  for (const vehicle_wiring &wiring : params_.wirings) {
+    for (const wiring_matrix &matrix : wiring.band) {
+      WriteValues(out, matrix.weight, kWiringWeightCount);
+    }
+  }
+
+  WriteValue(out, epoch_);
+  WriteValue(out, static_cast<int32_t>(game_status_));
+  WriteValue(out, static_cast<uint8_t>(game_paused_));
+  WriteValue(out, static_cast<uint8_t>(food_off_));
+  WriteValue(out, static_cast<uint64_t>(entities_.size()));
+  for (auto ent : entities_) {
+    ent->SaveState(out);
+  }
+
+  // The food readings kept by the robots, so that the restored arena keeps
+  // and recomputes the same ones
+  WriteValue(out, static_cast<uint64_t>(store_.food_cached.size()));
+  WriteValues(out, store_.food_cached.data(), store_.food_cached.size());
+  for (const std::vector<double> *cache : {&store_.cached_food_left,
+      &store_.cached_food_right, &store_.cached_left_x,
+      &store_.cached_left_y, &store_.cached_right_x,
+      &store_.cached_right_y}) {
+    WriteValues(out, cache->data(), cache->size());
+  }
+  WriteValue(out, static_cast<uint64_t>(food_signature_.size()));
+  WriteValues(out, food_signature_.data(), food_signature_.size());
+  return static_cast<bool>(out);
+} /* SaveCheckpoint() */
+
+bool Arena::ReadCheckpointParams(std::istream &in, arena_params *params) {
+  char magic[sizeof(CHECKPOINT_MAGIC)];
+  uint32_t version = 0, x_dim = 0, y_dim = 0, seed = 0;
+  uint64_t n_robots = 0, n_lights = 0, n_food = 0, light_sense = 0, ratio = 0;
+  uint8_t food_on = 0;
+  int32_t collision_mode = 0, sensing_mode = 0, response_mode = 0;
+  int32_t controller_mode = 0;
+  double epsilon = 0, food_radius = 0, field_cell_size = 0;
+  double food_threshold = 0;
+  wiring_table wirings;
+  if (!ReadValue(in, &magic) ||
+      std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0 ||
+      !ReadValue(in, &version) || version != CHECKPOINT_VERSION ||
+      !ReadValue(in, &x_dim) || !ReadValue(in, &y_dim) ||
+      !ReadValue(in, &n_robots) || !ReadValue(in, &n_lights) ||
+      !ReadValue(in, &n_food) || !ReadValue(in, &light_sense) ||
+      !ReadValue(in, &ratio) || !ReadValue(in, &food_on) ||
+      !ReadValue(in, &collision_mode) || !ReadValue(in, &sensing_mode) ||
+      !ReadValue(in, &epsilon) || !ReadValue(in, &food_radius) ||
+      !ReadValue(in, &response_mode) ||
+      !ReadValue(in, &field_cell_size) || !ReadValue(in, &food_threshold) ||
+      !ReadValue(in, &seed) ||
+      !ReadValue(in, &controller_mode)) {
+    return false;
+  }
+  for (vehicle_wiring &wiring : wirings) {
+    for (wiring_matrix &matrix : wiring.band) {
+      if (!ReadValue(in, &matrix.weight)) {
+        return false;
+      }
+    }
+  }
+  params->x_dim = x_dim;
+  params->y_dim = y_dim;
+  params->n_robots = static_cast<size_t>(n_robots);
+  params->n_lights = static_cast<size_t>(n_lights);
+  params->n_food = static_cast<size_t>(n_food);
+  params->n_light_sensitivity = static_cast<size_t>(light_sense);
+  params->n_ratio = static_cast<size_t>(ratio);
+  params->food_on = (food_on != 0);
+  params->collision_mode = static_cast<CollisionMode>(collision_mode);
+  params->sensing_mode = static_cast<SensingMode>(sensing_mode);
+  params->sensing_epsilon = epsilon;
+  params->food_sensing_radius = food_radius;
+  params->response_mode = static_cast<ResponseMode>(response_mode);
+  params->field_cell_size = field_cell_size;
+  params->food_sensing_threshold = food_threshold;
+  params->seed = seed;
+  params->controller_mode = static_cast<ControllerMode>(controller_mode);
+  params->wirings = wirings;
+  return true;
+} /* ReadCheckpointParams() */
+
+bool Arena::RestoreCheckpoint(std::istream &in) {
+  arena_params params = params_;
+  uint32_t epoch = 0;
+  int32_t game_status = 0;
+  uint8_t game_paused = 0, food_off = 0;
+  uint64_t n_entities = 0;
+  if (!ReadCheckpointParams(in, &params) || !ReadValue(in, &epoch) ||
+      !ReadValue(in, &game_status) || !ReadValue(in, &game_paused) ||
+      !ReadValue(in, &food_off) || !ReadValue(in, &n_entities) ||
+      n_entities != entities_.size() ||
+      params.n_robots != static_cast<size_t>(robot_count_) ||
+      params.n_lights != static_cast<size_t>(light_count_)) {
+    return false;
+  }
+  // Each entity checks that the saved state is its own
+  for (auto ent : entities_) {
+    if (!ent->LoadState(in)) {
+      return false;
+    }
+  }
+  EntityStore store;
+  uint64_t n_cached = 0, n_signature = 0;
+  if (!ReadValue(in, &n_cached) || n_cached > params.n_robots) {
+    return false;
+  }
+  store.Resize(static_cast<size_t>(n_cached), 0, 0);
+  if (!ReadValues(in, store.food_cached.data(), store.food_cached.size())) {
+    return false;
+  }
+  for (std::vector<double> *cache : {&store.cached_food_left,
+      &store.cached_food_right, &store.cached_left_x, &store.cached_left_y,
+      &store.cached_right_x, &store.cached_right_y}) {
+    if (!ReadValues(in, cache->data(), cache->size())) {
+      return false;
+    }
+  }
+  if (!ReadValue(in, &n_signature) || n_signature > 4 * params.n_food) {
+    return false;
+  }
+  std::vector<double> food_signature(static_cast<size_t>(n_signature));
+  if (!ReadValues(in, food_signature.data(), food_signature.size())) {
+    return false;
+  }
+
+  params_ = params;
+  x_dim_ = params.x_dim;
+  y_dim_ = params.y_dim;
+  rng_ = Rng(params.seed);
+  epoch_ = epoch;
+  game_status_ = game_status;
+  game_paused_ = (game_paused != 0);
+  food_off_ = (food_off != 0);
+  collision_mode_ = params.collision_mode;
+  if (robot_count_ > 0) {
+    light_sensitivity_ = robot_[0]->get_light_sensitivity();
+  }
+  set_sensing_mode(params.sensing_mode, params.sensing_epsilon);
+  set_response_mode(params.response_mode);
+  store_.food_cached.swap(store.food_cached);
+  store_.cached_food_left.swap(store.cached_food_left);
+  store_.cached_food_right.swap(store.cached_food_right);
+  store_.cached_left_x.swap(store.cached_left_x);
+  store_.cached_left_y.swap(store.cached_left_y);
+  store_.cached_right_x.swap(store.cached_right_x);
+  store_.cached_right_y.swap(store.cached_right_y);
+  // A checkpoint may have fewer cached readings than there are robots
+  store_.Resize(static_cast<size_t>(robot_count_),
+    static_cast<size_t>(light_count_), food_.size());
+  food_signature_.swap(food_signature);
+  RebuildDrawLabels();
+  PublishDrawSnapshot();
+  return true;
+} /* RestoreCheckpoint() */
+
 void Arena::Reset() {
   set_game_status(PLAYING);
+  epoch_++;
   for (auto ent : entities_) {
-    ent->Reset();
+    RandomStream random = rng_.Stream(ent->get_type(), ent->get_id(), epoch_);
+    ent->Reset(&random);
   } /* for(ent..) */
+  InvalidateFoodReadings();
+  PublishDrawSnapshot();
 } /* reset() */
 
 // The primary driver of simulation movement. Called from the Controller
 // but originated from the graphics viewer.
-void Arena::AdvanceTime(double dt) {
-  if (!game_paused_) {
-    if (!(dt > 0)) {
-    return;
-    }
-    for (size_t i = 0; i < 1; ++i) {
-      UpdateEntitiesTimestep();
-    } /* for(i..) */
-  }
+int Arena::AdvanceTime(int ticks) {
+  int ran = 0;
+  while (ran < ticks && !game_paused_ && get_game_status() == PLAYING) {
+    UpdateEntitiesTimestep();
+    ++ran;
+  } /* while(ran..) */
+  return ran;
 } /* AdvanceTime() */
 
 void Arena::UpdateEntitiesTimestep() {
+  //  Check for the game status.
+  if (get_game_status() != PLAYING) {
+    return;
+  }
+  PROFILE_TICK_BEGIN(profiler_);
+
   /*
-   * First, update the position of all entities, according to their current
-   * velocities.
+   * The timestep runs as a sequence of phases. Within a phase, the work for
+   * an entity only writes the state of that entity, so each phase is split
+   * among the threads of thread_pool_ and the result does not depend on the
+   * number of threads.
    */
-//  Check for the game status.
-if (get_game_status() == PLAYING) {
-  //  set all the robot's sensor reading to 0
-  for (int i = 0; i < robot_count_; i++) {
-    robot_[i]->reset_sensor_reading();
-  }
-  //  starts to update position and velocity of entities
-  for (auto ent : entities_) {
-    /* For non-robot entities, update their velocity and position, and notify
-     * each robot's sensors their position
-     */
-     if (kRobot != ent->get_type()) {
-      ent->TimestepUpdate(1);
-      //  Notify the light sensors of each robot about each light's position and
-      //  radius
-      if (kLight == ent->get_type()) {
-        for (int i = 0; i <robot_count_; i++) {
-          robot_[i] ->LightNotify(ent->get_pose(), ent->get_radius());
-        }
+
+  /*
+   * First, the lights pick their velocity and move. They do not depend on
+   * anything else in the arena.
+   */
+  thread_pool_.ParallelFor(0, static_cast<size_t>(light_count_),
+    [this](size_t begin, size_t end, size_t) {
+      for (size_t j = begin; j < end; j++) {
+        light_[j]->UpdateVelocity();
       }
-      //  Notify the food sensors of each robot about each food's position and
-      //  radius
-      if (kFood == ent->get_type()) {
-        for (int i = 0; i < robot_count_; i++) {
-          robot_[i]->FoodNotify(ent->get_pose(), ent->get_radius());
-
-          /* determine if the distance between robot and food is within 5 pixels
-           * if so, the robot is not hungry and reset the hungry level of robot
-           */
-          if (robot_[i]->IsFeeding(ent->get_pose(), ent->get_radius())) {
-            robot_[i]->reset_hungry_counter();
-          }
-        }
+    });
+  PROFILE_PHASE(profiler_, kPhaseIntegrate);
+  thread_pool_.ParallelFor(store_.light_begin(), store_.light_end(),
+    [this](size_t begin, size_t end, size_t) {
+      IntegratePoses(begin, end);
+    });
+
+  /*
+   * Then every robot's sensor readings are computed from scratch from the
+   * positions of the lights and food. A robot within 5 pixels of food is not
+   * hungry anymore.
+   */
+  PROFILE_PHASE(profiler_, kPhaseSense);
+  thread_pool_.ParallelFor(store_.robot_begin(), store_.robot_end(),
+    [this](size_t begin, size_t end, size_t) {
+      ResetSensors(begin, end);
+    });
+  RebuildSensingGrids();
+  if (kSenseField == sensing_mode_) {
+    UpdateStimulusFields();
+  } else {
+    CheckFoodChanges();
+  }
+  thread_pool_.ParallelFor(store_.robot_begin(), store_.robot_end(),
+    [this](size_t begin, size_t end, size_t chunk) {
+      if (kSenseCutoff == sensing_mode_) {
+        SenseUsingGrid(begin, end, &scratch_[chunk]);
+      } else if (kSenseField == sensing_mode_) {
+        SenseUsingField(begin, end, &scratch_[chunk]);
+      } else {
+        SenseAll(begin, end, &scratch_[chunk]);
       }
-    }
-}
+    });
+
   // For robots, update their velocity, position and hungry level according to
   // their sensor readings
-
+  PROFILE_PHASE(profiler_, kPhaseControl);
+  thread_pool_.ParallelFor(store_.robot_begin(), store_.robot_end(),
+    [this](size_t begin, size_t end, size_t chunk) {
+      UpdateRobotControllers(begin, end, &scratch_[chunk]);
+    });
+  //  if one of the robots is dead, set the game status to LOST, the game
+  //  should be stop.
   for (int i = 0; i < robot_count_; i++) {
-    robot_[i]->TimestepUpdate(1);
-    robot_[i]->increase_hungry();
-
-    //  if one of the robots is dead, set the game status to LOST, the game
-    //  should be stop.
     if (robot_[i]->get_status() == LOST) {
       set_game_status(LOST);
       break;
     }
   }
+  PROFILE_PHASE(profiler_, kPhaseIntegrate);
+  thread_pool_.ParallelFor(store_.robot_begin(), store_.robot_end(),
+    [this](size_t begin, size_t end, size_t) {
+      IntegratePoses(begin, end);
+    });
 
-   /* Determine if any mobile entity is colliding with wall.
-   * Adjust the position accordingly so it doesn't overlap.
+  /* Determine if any mobile entity is colliding with a wall or with another
+   * entity. Adjust the position accordingly so it doesn't overlap.
    */
-  for (auto &ent1 : mobile_entities_) {
-    EntityType wall = GetCollisionWall(ent1);
-    if (kUndefined != wall) {
-      if (ent1->get_type() == kRobot) {
-        AdjustWallOverlap(ent1, wall);
-        dynamic_cast<Robot*> (ent1)->HandleCollision();
-      } else {
-        AdjustWallOverlap(ent1, wall);
-        dynamic_cast<Light*>(ent1)->HandleCollision();
-      }
+  PROFILE_PHASE(profiler_, kPhaseWalls);
+  thread_pool_.ParallelFor(0, store_.mobile_end(),
+    [this](size_t begin, size_t end, size_t chunk) {
+      ResolveWallCollisions(begin, end, &scratch_[chunk]);
+    });
+  PROFILE_PHASE(profiler_, kPhaseOverlaps);
+  if (kCollisionGrid == collision_mode_) {
+    RebuildCollisionGrid();
+  }
+  thread_pool_.ParallelFor(0, store_.mobile_end(),
+    [this](size_t begin, size_t end, size_t chunk) {
+      ResolveEntityOverlaps(begin, end, &scratch_[chunk]);
+    });
+  // Only now that every overlap is resolved can the entities move there
+  std::copy(store_.resolved_x.begin(), store_.resolved_x.end(),
+    store_.x.begin());
+  std::copy(store_.resolved_y.begin(), store_.resolved_y.end(),
+    store_.y.begin());
+  PROFILE_PHASE(profiler_, kPhasePublish);
+  PublishDrawSnapshot();
+  if (recorder_) {
+    recorder_->Record(store_, robot_);
+  }
+  PROFILE_ONLY(CollectCounts());
+  PROFILE_TICK_END(profiler_);
+}  // UpdateEntitiesTimestep()
+
+void Arena::CollectCounts() {
+  for (auto &scratch : scratch_) {
+    for (int c = 0; c < kCounterCount; c++) {
+      profiler_.Count(static_cast<TickCounter>(c), scratch.counts[c]);
+      scratch.counts[c] = 0;
+    }
+  }
+} /* CollectCounts() */
+
+void Arena::BindEntityStore() {
+  store_.Resize(static_cast<size_t>(robot_count_),
+    static_cast<size_t>(light_count_), food_.size());
+  for (size_t i = 0; i < entities_.size(); i++) {
+    entities_[i]->BindStore(&store_, i);
+  }
+} /* BindEntityStore() */
+
+void Arena::RebuildDrawLabels() {
+  std::vector<std::string> labels;
+  std::map<std::string, uint32_t> label_of;
+  draw_label_.resize(entities_.size());
+  for (size_t i = 0; i < entities_.size(); i++) {
+    std::string name = entities_[i]->get_name();
+    auto found = label_of.find(name);
+    if (found == label_of.end()) {
+      found = label_of.emplace(name,
+        static_cast<uint32_t>(labels.size())).first;
+      labels.push_back(name);
     }
+    draw_label_[i] = found->second;
+  }
+  draw_labels_ = std::make_shared<const std::vector<std::string>>(
+    std::move(labels));
+} /* RebuildDrawLabels() */
+
+void Arena::set_draw_snapshot(DrawSnapshot *snapshot) {
+  draw_snapshot_ = (snapshot) ? snapshot : &own_draw_snapshot_;
+  PublishDrawSnapshot();
+} /* set_draw_snapshot() */
 
-    /* Determine if that mobile entity is colliding with any other entity.
-    * Adjust the position accordingly so they don't overlap.
-    */
-    for (auto &ent2 : entities_) {
-      if (ent2 == ent1) {continue;}
-       if (IsColliding(ent1, ent2)) {
-      if (ent1->get_type() == kLight && ent2->get_type() == kLight) {
-        AdjustEntityOverlap(ent1, ent2);
-        dynamic_cast<Light*>(ent1)->HandleCollision();
+void Arena::PublishDrawSnapshot() {
+  draw_frame *frame = draw_snapshot_->get_back();
+  std::vector<draw_record> &records = frame->records;
+  records.resize(entities_.size());
+  for (size_t i = 0; i < entities_.size(); i++) {
+    const ArenaEntity *entity = entities_[i];
+    draw_record &record = records[i];
+    record.x = static_cast<float>(entity->get_pose().x);
+    record.y = static_cast<float>(entity->get_pose().y);
+    record.theta = static_cast<float>(entity->get_pose().theta);
+    record.radius = static_cast<float>(entity->get_radius());
+    record.r = static_cast<uint8_t>(entity->get_color().r);
+    record.g = static_cast<uint8_t>(entity->get_color().g);
+    record.b = static_cast<uint8_t>(entity->get_color().b);
+    record.type = static_cast<uint8_t>(entity->get_type());
+    record.label = draw_label_[i];
+  }
+  frame->labels = draw_labels_;
+  frame->game_status = game_status_;
+  frame->stats = get_tick_stats();
+  if (draw_tile_size_ > 0) {
+    BuildDrawTiles(x_dim_, y_dim_, draw_tile_size_, frame);
+  } else {
+    frame->tiles.clear();
+    frame->tile_order.clear();
+  }
+  draw_snapshot_->Publish();
+} /* PublishDrawSnapshot() */
+
+void Arena::IntegratePoses(size_t begin, size_t end) {
+  IntegrateDifferentialDrive(end - begin, 1, store_.vel_left.data() + begin,
+    store_.vel_right.data() + begin, store_.x.data() + begin,
+    store_.y.data() + begin, store_.theta.data() + begin);
+} /* IntegratePoses() */
+
+void Arena::ResetSensors(size_t begin, size_t end) {
+  for (size_t r = begin; r < end; r++) {
+    Pose pose(store_.x[r], store_.y[r], store_.theta[r]);
+    Pose left = Robot::SensorPosition(pose, store_.radius[r], LEFT_SENSOR);
+    Pose right = Robot::SensorPosition(pose, store_.radius[r], RIGHT_SENSOR);
+    store_.left_x[r] = left.x;
+    store_.left_y[r] = left.y;
+    store_.right_x[r] = right.x;
+    store_.right_y[r] = right.y;
+    store_.light_left[r] = 0;
+    store_.light_right[r] = 0;
+    store_.food_left[r] = 0;
+    store_.food_right[r] = 0;
+    store_.feeding[r] = false;
+  }
+} /* ResetSensors() */
+
+void Arena::SenseLights(size_t n_sensors, const double *sensor_x,
+  const double *sensor_y, const double *sensitivity, size_t n_lights,
+  const double *light_x, const double *light_y, const double *light_radius,
+  double *readings) const {
+  if (kResponseTable == params_.response_mode) {
+    AccumulateTableReadings(light_table_, n_sensors, sensor_x, sensor_y,
+      n_lights, light_x, light_y, light_radius, light_cutoff_, readings);
+  } else if (kResponsePolynomial == params_.response_mode) {
+    AccumulateLightReadings(n_sensors, sensor_x, sensor_y, sensitivity,
+      n_lights, light_x, light_y, light_radius, light_cutoff_, readings);
+  } else {
+    // As LightSensor::CalculateSensorReading(), one light at a time
+    for (size_t i = 0; i < n_sensors; i++) {
+      for (size_t j = 0; j < n_lights; j++) {
+        double distance = Sensor::DistanceToSource(sensor_x[i], sensor_y[i],
+          light_x[j], light_y[j], light_radius[j]);
+        if (!(distance > light_cutoff_)) {
+          readings[i] = Sensor::AddContribution(readings[i], sensitivity[i],
+            distance);
+        }
       }
-      if (ent1->get_type() == kRobot && ent2->get_type() == kRobot) {
-        AdjustEntityOverlap(ent1, ent2);
-        dynamic_cast<Robot*>(ent1)->HandleCollision();
+    }
+  }
+} /* SenseLights() */
+
+double Arena::FoodResponse(double reading, double distance) const {
+  if (kResponseTable == params_.response_mode) {
+    return Sensor::AddResponse(reading, food_table_.Response(distance));
+  }
+  return Sensor::AddContribution(reading, FOOD_SENSITIVITY, distance);
+} /* FoodResponse() */
+
+void Arena::SenseFood(size_t r, size_t source,
+  __unused QueryScratch *scratch) {
+  double distance = Sensor::DistanceToSource(store_.left_x[r],
+    store_.left_y[r], store_.x[source], store_.y[source],
+    store_.radius[source]);
+  if (!(distance > food_cutoff_)) {
+    store_.food_left[r] = FoodResponse(store_.food_left[r], distance);
+    PROFILE_ONLY(scratch->counts[kCountResponses]++);
+  }
+  distance = Sensor::DistanceToSource(store_.right_x[r], store_.right_y[r],
+    store_.x[source], store_.y[source], store_.radius[source]);
+  if (!(distance > food_cutoff_)) {
+    store_.food_right[r] = FoodResponse(store_.food_right[r], distance);
+    PROFILE_ONLY(scratch->counts[kCountResponses]++);
+  }
+
+  /* determine if the distance between robot and food is within 5 pixels
+   * if so, the robot is not hungry and reset the hungry level of robot
+   */
+  if (Robot::IsWithinFeedingRange(store_.x[r], store_.y[r], store_.radius[r],
+    store_.x[source], store_.y[source], store_.radius[source])) {
+    store_.feeding[r] = true;
+  }
+} /* SenseFood() */
+
+void Arena::InvalidateFoodReadings() {
+  std::fill(store_.food_cached.begin(), store_.food_cached.end(), 0);
+} /* InvalidateFoodReadings() */
+
+void Arena::CheckFoodChanges() {
+  bool changed = food_signature_.size() != 4 * store_.n_food;
+  food_signature_.resize(4 * store_.n_food);
+  for (size_t i = 0; i < store_.n_food; i++) {
+    size_t f = store_.food_begin() + i;
+    double signature[4] = {store_.x[f], store_.y[f], store_.radius[f],
+      food_[i]->IsCaptured() ? 1.0 : 0.0};
+    double *kept = &food_signature_[4 * i];
+    if (std::memcmp(kept, signature, sizeof(signature)) != 0) {
+      std::memcpy(kept, signature, sizeof(signature));
+      changed = true;
+    }
+  }
+  if (changed) {
+    InvalidateFoodReadings();
+  }
+} /* CheckFoodChanges() */
+
+bool Arena::ReuseFoodReadings(size_t r, QueryScratch *scratch) {
+  if (!store_.food_cached[r]) {
+    return false;
+  }
+  double threshold = params_.food_sensing_threshold;
+  double left_x = store_.left_x[r] - store_.cached_left_x[r];
+  double left_y = store_.left_y[r] - store_.cached_left_y[r];
+  double right_x = store_.right_x[r] - store_.cached_right_x[r];
+  double right_y = store_.right_y[r] - store_.cached_right_y[r];
+  if (left_x * left_x + left_y * left_y > threshold * threshold ||
+      right_x * right_x + right_y * right_y > threshold * threshold) {
+    return false;
+  }
+  store_.food_left[r] = store_.cached_food_left[r];
+  store_.food_right[r] = store_.cached_food_right[r];
+  SenseFeeding(r, scratch);
+  return true;
+} /* ReuseFoodReadings() */
+
+void Arena::KeepFoodReadings(size_t r) {
+  store_.food_cached[r] = 1;
+  store_.cached_food_left[r] = store_.food_left[r];
+  store_.cached_food_right[r] = store_.food_right[r];
+  store_.cached_left_x[r] = store_.left_x[r];
+  store_.cached_left_y[r] = store_.left_y[r];
+  store_.cached_right_x[r] = store_.right_x[r];
+  store_.cached_right_y[r] = store_.right_y[r];
+} /* KeepFoodReadings() */
+
+void Arena::SenseFeeding(size_t r, QueryScratch *scratch) {
+  double food_reach = 5.0 + store_.radius[r] + max_food_radius_;
+  food_grid_.Query(store_.x[r], store_.y[r], food_reach, &scratch->ids);
+  for (int id : scratch->ids) {
+    size_t f = static_cast<size_t>(id);
+    if (Robot::IsWithinFeedingRange(store_.x[r], store_.y[r],
+      store_.radius[r], store_.x[f], store_.y[f], store_.radius[f])) {
+      store_.feeding[r] = true;
+    }
+  }
+} /* SenseFeeding() */
+
+void Arena::SenseAll(size_t begin, size_t end,
+  __unused QueryScratch *scratch) {
+  size_t lights = store_.light_begin();
+  SenseLights(end - begin, store_.left_x.data() + begin,
+    store_.left_y.data() + begin, store_.light_sensitivity.data() + begin,
+    store_.n_lights, store_.x.data() + lights, store_.y.data() + lights,
+    store_.radius.data() + lights, store_.light_left.data() + begin);
+  SenseLights(end - begin, store_.right_x.data() + begin,
+    store_.right_y.data() + begin, store_.light_sensitivity.data() + begin,
+    store_.n_lights, store_.x.data() + lights, store_.y.data() + lights,
+    store_.radius.data() + lights, store_.light_right.data() + begin);
+
+  PROFILE_ONLY(scratch->counts[kCountResponses] +=
+    2 * (end - begin) * store_.n_lights);
+
+  for (size_t r = begin; r < end; r++) {
+    if (ReuseFoodReadings(r, scratch)) {
+      continue;
+    }
+    for (size_t f = store_.food_begin(); f < store_.food_end(); f++) {
+      SenseFood(r, f, scratch);
+    }
+    KeepFoodReadings(r);
+  }
+} /* SenseAll() */
+
+void Arena::RebuildSensingGrids() {
+  light_grid_.Clear();
+  food_grid_.Clear();
+  max_light_radius_ = 0;
+  max_food_radius_ = 0;
+  // In kSenseField mode, the lights are only read through light_field_
+  if (kSenseCutoff == sensing_mode_) {
+    for (size_t j = store_.light_begin(); j < store_.light_end(); j++) {
+      light_grid_.Insert(static_cast<int>(j), store_.x[j], store_.y[j]);
+      max_light_radius_ = std::max(max_light_radius_, store_.radius[j]);
+    }
+  }
+  for (size_t f = store_.food_begin(); f < store_.food_end(); f++) {
+    food_grid_.Insert(static_cast<int>(f), store_.x[f], store_.y[f]);
+    max_food_radius_ = std::max(max_food_radius_, store_.radius[f]);
+  }
+} /* RebuildSensingGrids() */
+
+void Arena::SenseUsingGrid(size_t begin, size_t end,
+  __unused QueryScratch *scratch) {
+  for (size_t r = begin; r < end; r++) {
+    // The sensors sit on the edge of the robot.
+    double light_reach = light_cutoff_ + store_.radius[r] + max_light_radius_;
+    light_grid_.Query(store_.x[r], store_.y[r], light_reach, &scratch->ids);
+    scratch->x.clear();
+    scratch->y.clear();
+    scratch->radius.clear();
+    for (int id : scratch->ids) {
+      scratch->x.push_back(store_.x[id]);
+      scratch->y.push_back(store_.y[id]);
+      scratch->radius.push_back(store_.radius[id]);
+    }
+    SenseLights(1, &store_.left_x[r], &store_.left_y[r],
+      &store_.light_sensitivity[r], scratch->x.size(), scratch->x.data(),
+      scratch->y.data(), scratch->radius.data(), &store_.light_left[r]);
+    SenseLights(1, &store_.right_x[r], &store_.right_y[r],
+      &store_.light_sensitivity[r], scratch->x.size(), scratch->x.data(),
+      scratch->y.data(), scratch->radius.data(), &store_.light_right[r]);
+    PROFILE_ONLY(scratch->counts[kCountResponses] += 2 * scratch->x.size());
+
+    if (ReuseFoodReadings(r, scratch)) {
+      continue;
+    }
+    // Feeding is never culled: a robot within 5 units of food always eats.
+    double food_reach = std::max(food_cutoff_, 5.0) + store_.radius[r]
+      + max_food_radius_;
+    food_grid_.Query(store_.x[r], store_.y[r], food_reach, &scratch->ids);
+    for (int id : scratch->ids) {
+      SenseFood(r, static_cast<size_t>(id), scratch);
+    }
+    KeepFoodReadings(r);
+  }
+} /* SenseUsingGrid() */
+
+void Arena::UpdateStimulusFields() {
+  size_t lights = store_.light_begin();
+  light_field_.Update(store_.n_lights, store_.x.data() + lights,
+    store_.y.data() + lights, store_.radius.data() + lights, &thread_pool_);
+  size_t food = store_.food_begin();
+  food_field_.Update(store_.n_food, store_.x.data() + food,
+    store_.y.data() + food, store_.radius.data() + food, &thread_pool_);
+  PROFILE_ONLY(profiler_.Count(kCountFieldTiles,
+    light_field_.get_n_rasterized_tiles() +
+    food_field_.get_n_rasterized_tiles()));
+} /* UpdateStimulusFields() */
+
+void Arena::SenseUsingField(size_t begin, size_t end,
+  __unused QueryScratch *scratch) {
+  for (size_t r = begin; r < end; r++) {
+    store_.light_left[r] = Sensor::AddResponse(store_.light_left[r],
+      light_field_.Sample(store_.left_x[r], store_.left_y[r]));
+    store_.light_right[r] = Sensor::AddResponse(store_.light_right[r],
+      light_field_.Sample(store_.right_x[r], store_.right_y[r]));
+    store_.food_left[r] = Sensor::AddResponse(store_.food_left[r],
+      food_field_.Sample(store_.left_x[r], store_.left_y[r]));
+    store_.food_right[r] = Sensor::AddResponse(store_.food_right[r],
+      food_field_.Sample(store_.right_x[r], store_.right_y[r]));
+    SenseFeeding(r, scratch);
+  }
+} /* SenseUsingField() */
+
+void Arena::UpdateRobotControllers(size_t begin, size_t end,
+  QueryScratch *scratch) {
+  scratch->wired.clear();
+  for (auto &behavior : scratch->group) {
+    for (auto &group : behavior) {
+      group.clear();
+    }
+  }
+  for (size_t i = begin; i < end; i++) {
+    robot_[i]->set_sensor_readings(store_.light_left[i],
+      store_.light_right[i], store_.food_left[i], store_.food_right[i]);
+    if (store_.feeding[i]) {
+      robot_[i]->reset_hungry_counter();
+    }
+    // Dead and reverse arcing robots do not use their controller
+    if (robot_[i]->is_dead() || robot_[i]->is_reverse_arcing()) {
+      robot_[i]->UpdateVelocity();
+    } else if (kControllerWiring == params_.controller_mode) {
+      scratch->wired.push_back(i);
+    } else {
+      scratch->group[robot_[i]->get_behavior()]
+        [robot_[i]->get_hunger_band()].push_back(i);
+    }
+  }
+
+  RunWiredControllers(scratch->wired, &scratch->batch);
+  for (size_t behavior = 0; behavior < kBehaviorCount; behavior++) {
+    for (int band = 0; band < kHungerBandCount; band++) {
+      RunControllerGroup(static_cast<RobotType>(behavior),
+        static_cast<HungerBand>(band), scratch->group[behavior][band],
+        &scratch->batch);
+    }
+  }
+
+  for (size_t i = begin; i < end; i++) {
+    // A dead robot does not move
+    if (robot_[i]->is_dead()) {
+      robot_[i]->set_velocity(0, 0);
+    }
+    robot_[i]->increase_hungry();
+    PROFILE_ONLY(scratch->counts[kCountReverseArcs] +=
+      robot_[i]->is_reverse_arcing());
+  }
+} /* UpdateRobotControllers() */
+
+void Arena::RunControllerGroup(RobotType behavior, HungerBand band,
+  const std::vector<size_t> &robots, std::vector<double> *batch_buffer) {
+  size_t n = robots.size();
+  if (0 == n) {
+    return;
+  }
+  batch_buffer->resize(7 * n);
+  double *buffer = batch_buffer->data();
+  double *light_left = buffer, *light_right = buffer + n;
+  double *food_left = buffer + 2 * n, *food_right = buffer + 3 * n;
+  double *max_speed = buffer + 4 * n;
+  for (size_t k = 0; k < n; k++) {
+    size_t i = robots[k];
+    light_left[k] = store_.light_left[i];
+    light_right[k] = store_.light_right[i];
+    food_left[k] = store_.food_left[i];
+    food_right[k] = store_.food_right[i];
+    max_speed[k] = robot_[i]->get_motion_handler()->get_max_speed();
+  }
+  controller_batch batch;
+  batch.light_left = light_left;
+  batch.light_right = light_right;
+  batch.food_left = food_left;
+  batch.food_right = food_right;
+  batch.max_speed = max_speed;
+  batch.vel_left = buffer + 5 * n;
+  batch.vel_right = buffer + 6 * n;
+  ControllerKernelFor(behavior, band)(n, batch);
+  for (size_t k = 0; k < n; k++) {
+    robot_[robots[k]]->get_motion_handler()->set_velocity(batch.vel_left[k],
+      batch.vel_right[k]);
+  }
+} /* RunControllerGroup() */
+
+void Arena::RunWiredControllers(const std::vector<size_t> &robots,
+  std::vector<double> *batch_buffer) {
+  size_t n = robots.size();
+  if (0 == n) {
+    return;
+  }
+  batch_buffer->resize((kWiringWeightCount + 7) * n);
+  double *weights = batch_buffer->data();
+  double *light_left = weights + kWiringWeightCount * n;
+  double *light_right = light_left + n, *food_left = light_left + 2 * n;
+  double *food_right = light_left + 3 * n, *max_speed = light_left + 4 * n;
+  double *vel_left = light_left + 5 * n, *vel_right = light_left + 6 * n;
+  for (size_t k = 0; k < n; k++) {
+    size_t i = robots[k];
+    const wiring_matrix &matrix = params_.wirings[robot_[i]->get_behavior()]
+      .band[robot_[i]->get_hunger_band()];
+    for (size_t w = 0; w < kWiringWeightCount; w++) {
+      weights[w * n + k] = matrix.weight[w];
+    }
+    light_left[k] = store_.light_left[i];
+    light_right[k] = store_.light_right[i];
+    food_left[k] = store_.food_left[i];
+    food_right[k] = store_.food_right[i];
+    max_speed[k] = robot_[i]->get_motion_handler()->get_max_speed();
+  }
+  ApplyWirings(n, weights, light_left, light_right, food_left, food_right,
+    max_speed, vel_left, vel_right);
+  for (size_t k = 0; k < n; k++) {
+    robot_[robots[k]]->get_motion_handler()->set_velocity(vel_left[k],
+      vel_right[k]);
+  }
+} /* RunWiredControllers() */
+
+void Arena::HandleCollision(size_t i) {
+  if (i < store_.robot_end()) {
+    robot_[i]->HandleCollision();
+  } else {
+    light_[i - store_.light_begin()]->HandleCollision();
+  }
+} /* HandleCollision() */
+
+void Arena::ResolveWallCollisions(size_t begin, size_t end,
+  __unused QueryScratch *scratch) {
+  for (size_t i = begin; i < end; i++) {
+    EntityType wall = WallAt(store_.x[i], store_.y[i], store_.radius[i],
+      x_dim_, y_dim_);
+    if (kUndefined != wall) {
+      PushOffWall(&store_.x[i], &store_.y[i], store_.radius[i], x_dim_,
+        y_dim_, wall);
+      HandleCollision(i);
+      PROFILE_ONLY(scratch->counts[kCountWallCollisions]++);
+    }
+  }
+} /* ResolveWallCollisions() */
+
+void Arena::ResolveEntityOverlaps(size_t begin, size_t end,
+  __unused QueryScratch *scratch) {
+  for (size_t i = begin; i < end; i++) {
+    store_.resolved_x[i] = store_.x[i];
+    store_.resolved_y[i] = store_.y[i];
+    if (kCollisionGrid == collision_mode_) {
+      ResolveEntityOverlapUsingGrid(i, scratch);
+    } else {
+      for (size_t j = 0; j < store_.size(); j++) {
+        if (j != i) {
+          ResolveEntityOverlap(i, j, scratch);
+        }
       }
     }
   }
-}
-}
-}  // UpdateEntitiesTimestep()
+} /* ResolveEntityOverlaps() */
+
+bool Arena::ResolveEntityOverlap(size_t i, size_t j,
+  __unused QueryScratch *scratch) {
+  PROFILE_ONLY(scratch->counts[kCountPairsTested]++);
+  // robots only bounce off robots, lights only bounce off lights
+  bool same_type = (i < store_.robot_end()) ? (j < store_.robot_end()) :
+    (j >= store_.light_begin() && j < store_.light_end());
+  if (!same_type || !CirclesOverlap(store_.resolved_x[i],
+    store_.resolved_y[i], store_.radius[i], store_.x[j], store_.y[j],
+    store_.radius[j])) {
+    return false;
+  }
+  PushOutOfCircle(&store_.resolved_x[i], &store_.resolved_y[i],
+    store_.radius[i], store_.x[j], store_.y[j], store_.radius[j]);
+  HandleCollision(i);
+  PROFILE_ONLY(scratch->counts[kCountCollisions]++);
+  return true;
+} /* ResolveEntityOverlap() */
 
+void Arena::RebuildCollisionGrid() {
+  double max_radius = 0;
+  for (size_t i = 0; i < store_.size(); i++) {
+    max_radius = std::max(max_radius, store_.radius[i]);
+  }
+  collision_reach_ = 2 * max_radius;
+  if (collision_grid_.get_cols() == 0 ||
+      std::fabs(collision_grid_.get_cell_size() - collision_reach_) > 0) {
+    collision_grid_.Resize(x_dim_, y_dim_, collision_reach_);
+  } else {
+    collision_grid_.Clear();
+  }
+  for (size_t i = 0; i < store_.size(); i++) {
+    collision_grid_.Insert(static_cast<int>(i), store_.x[i], store_.y[i]);
+  }
+} /* RebuildCollisionGrid() */
+
+void Arena::ResolveEntityOverlapUsingGrid(size_t index,
+  __unused QueryScratch *scratch) {
+  int self = static_cast<int>(index);
+  int next = 0;
+  bool moved = true;
+  while (moved) {
+    moved = false;
+    collision_grid_.Query(store_.resolved_x[index], store_.resolved_y[index],
+      collision_reach_, &scratch->ids);
+    for (int id : scratch->ids) {
+      if (id < next) {continue;}
+      next = id + 1;
+      if (id == self) {continue;}
+      if (ResolveEntityOverlap(index, static_cast<size_t>(id), scratch)) {
+        // Pushed away: the entities after id must be looked up around the
+        // new position.
+        moved = true;
+        break;
+      }
+    }
+  }
+} /* ResolveEntityOverlapUsingGrid() */
 
 // Determine if the entity is colliding with a wall.
 // Always returns an entity type. If not collision, returns kUndefined.
 EntityType Arena::GetCollisionWall(ArenaMobileEntity *const ent) {
-  if (ent->get_pose().x + ent->get_radius() >= x_dim_) {
-    return kRightWall;  // at x = x_dim_
-  } else if (ent->get_pose().x - ent->get_radius() <= 0) {
-    return kLeftWall;  // at x = 0
-  } else if (ent->get_pose().y + ent->get_radius() >= y_dim_) {
-    return kBottomWall;  // at y = y_dim
-  } else if (ent->get_pose().y - ent->get_radius() <= 0) {
-    return kTopWall;  // at y = 0
-  } else {
-    return kUndefined;
-  }
+  return WallAt(ent->get_pose().x, ent->get_pose().y, ent->get_radius(),
+    x_dim_, y_dim_);
 } /* GetCollisionWall() */
 
 /* The entity type indicates which wall the entity is colliding with.
@@ -223,33 +1143,18 @@ EntityType Arena::GetCollisionWall(ArenaMobileEntity *const ent) {
 void Arena::AdjustWallOverlap(ArenaMobileEntity *const ent,
   EntityType object) {
   Pose entity_pos = ent->get_pose();
-  switch (object) {
-    case (kRightWall):  // at x = x_dim_
-    ent->set_position(x_dim_-(ent->get_radius()+5), entity_pos.y);
-    break;
-    case (kLeftWall):  // at x = 0
-    ent->set_position(ent->get_radius()+5, entity_pos.y);
-    break;
-    case (kTopWall):  // at y = 0
-    ent->set_position(entity_pos.x, ent->get_radius()+5);
-    break;
-    case (kBottomWall):  // at y = y_dim_
-    ent->set_position(entity_pos.x, y_dim_-(ent->get_radius()+5));
-    break;
-    default:
-    {}
-  }
+  PushOffWall(&entity_pos.x, &entity_pos.y, ent->get_radius(), x_dim_, y_dim_,
+    object);
+  ent->set_position(entity_pos.x, entity_pos.y);
 }
 
 /* Calculates the distance between the center points to determine overlap */
 bool Arena::IsColliding(
   ArenaMobileEntity * const mobile_e,
   ArenaEntity * const other_e) {
-    double delta_x = other_e->get_pose().x - mobile_e->get_pose().x;
-    double delta_y = other_e->get_pose().y - mobile_e->get_pose().y;
-    double distance_between = sqrt(delta_x*delta_x + delta_y*delta_y);
-    return
-    (distance_between <= (mobile_e->get_radius() + other_e->get_radius()));
+    return CirclesOverlap(mobile_e->get_pose().x, mobile_e->get_pose().y,
+      mobile_e->get_radius(), other_e->get_pose().x, other_e->get_pose().y,
+      other_e->get_radius());
 }
 
 /* This is called when it is known that the two entities overlap.
@@ -258,18 +1163,13 @@ bool Arena::IsColliding(
 */
 void Arena::AdjustEntityOverlap(ArenaMobileEntity * const mobile_e,
   ArenaEntity *const other_e) {
-        double delta_x = mobile_e->get_pose().x - other_e->get_pose().x;
-        double delta_y = mobile_e->get_pose().y - other_e->get_pose().y;
-        double distance_between = sqrt(delta_x*delta_x + delta_y*delta_y);
-        double distance_to_move = mobile_e->get_radius() + other_e->get_radius()
-        - distance_between + 5;
-        double angle = atan2(delta_y, delta_x);
-        mobile_e->set_position(
-           mobile_e->get_pose().x+cos(angle)*distance_to_move,
-           mobile_e->get_pose().y+sin(angle)*distance_to_move);
+        Pose entity_pos = mobile_e->get_pose();
+        PushOutOfCircle(&entity_pos.x, &entity_pos.y, mobile_e->get_radius(),
+          other_e->get_pose().x, other_e->get_pose().y,
+          other_e->get_radius());
+        mobile_e->set_position(entity_pos.x, entity_pos.y);
 }
 
-
 // Accept communication from the controller. Dispatching as appropriate.
 /** Call the appropriate Robot functions to implement user input
   * for controlling the robot.
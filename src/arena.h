@@ -12,13 +12,27 @@
  ******************************************************************************/
 #include <cmath>
 #include <iostream>
+#include <memory>
+#include <string>
 #include <vector>
 
+#include "src/arena_params.h"
+#include "src/collision_mode.h"
 #include "src/common.h"
 #include "src/food.h"
 #include "src/entity_factory.h"
+#include "src/rng.h"
 #include "src/robot.h"
+#include "src/robot_policy.h"
 #include "src/communication.h"
+#include "src/draw_snapshot.h"
+#include "src/entity_store.h"
+#include "src/response_table.h"
+#include "src/sensing_mode.h"
+#include "src/spatial_grid.h"
+#include "src/stimulus_field.h"
+#include "src/thread_pool.h"
+#include "src/tick_profiler.h"
 
 /*******************************************************************************
  * Namespaces
@@ -28,7 +42,7 @@ NAMESPACE_BEGIN(csci3081);
 /*******************************************************************************
  * Class Definitions
  ******************************************************************************/
-struct arena_params;
+class TrajectoryRecorder;
 
 /**
  * @brief The main class for the simulation of a 2D world with many entities
@@ -58,16 +72,17 @@ class Arena {
   ~Arena();
 
   /**
-   * @brief Advance the simulation by the specified # of steps.
+   * @brief Advance the simulation by the specified # of timesteps.
    *
-   * @param[in] dt The # of steps to increment by. This is
-   * practically unused because the arena state is advanced
-   * incrementally at a fixed rate.
+   * @param[in] ticks The # of timesteps to run, as decided by the
+   * SimulationClock of the Controller.
    *
-   * If `dt == 0`, `return` immediately. Otherwise calls
-   * Arena::UpdateEntitiesTimestep() once.
+   * Calls Arena::UpdateEntitiesTimestep() up to ticks times, and stops early
+   * if the game is paused or over.
+   *
+   * @return The # of timesteps actually run.
    */
-  void AdvanceTime(double dt);
+  int AdvanceTime(int ticks);
 
   /**
    * @brief Construct and Create robots by calling EntityFactory::CreateEntity()
@@ -101,6 +116,15 @@ class Arena {
    */
   void Reset();
 
+  /**
+   * @brief Make the Arena as it would be if built from params, reusing what
+   * it holds: the slots of its entities, its buffers and grids, and its
+   * threads, whose # is kept as in RestoreCheckpoint().
+   *
+   * The profiler, recorder and draw target of the Arena are kept.
+   */
+  void Reconfigure(const struct arena_params *const params);
+
 
   /**
    * @brief Under certain circumstance, the compiler requires that the
@@ -161,9 +185,14 @@ class Arena {
   /**
    * @brief Update all entities for a single timestep.
    *
-   * First calls each entity's TimestepUpdate method to update their speed,
-   * heading angle, and position. Then check for collisions between entities
-   * or between an entity and a wall.
+   * The lights move first. Then the robots' sensors read the new light and
+   * food positions, and each robot updates its speed, heading angle, position
+   * and hungry level. Finally, collisions between entities or between an
+   * entity and a wall are resolved.
+   *
+   * Sensing, pose integration and collisions run over the arrays of store_,
+   * which hold the state of the entities, split among arena_params::n_threads
+   * threads. The result is the same whatever the number of threads.
    */
   void UpdateEntitiesTimestep();
 
@@ -172,7 +201,30 @@ class Arena {
   *
   * return a vector that contains all entities mobile and immobile in the arena.
   */
-  std::vector<class ArenaEntity *> get_entities() const { return entities_; }
+  const std::vector<class ArenaEntity *> &get_entities() const {
+    return entities_;
+  }
+
+  /**
+   * @brief What to draw of every entity, as of the end of the last timestep
+   * (or of the last Reset() or RestoreCheckpoint()).
+   */
+  DrawSnapshot &get_draw_snapshot() { return *draw_snapshot_; }
+
+  /**
+   * @brief Publish the frames to snapshot instead of to the Arena's own,
+   * e.g. to one that outlives the Arena; nullptr goes back to the Arena's
+   * own. The Arena does not own the snapshot. The current frame is
+   * published to it right away.
+   */
+  void set_draw_snapshot(DrawSnapshot *snapshot);
+
+  /**
+   * @brief Also sort the records of the frames published into tiles of the
+   * given size (see BuildDrawTiles()), for the viewer to only go through
+   * those it shows. 0, the default, does not.
+   */
+  void set_draw_tile_size(double tile_size) { draw_tile_size_ = tile_size; }
 
   double get_x_dim() { return x_dim_; }
   double get_y_dim() { return y_dim_; }
@@ -180,24 +232,423 @@ class Arena {
   int get_game_status() const { return game_status_; }
   void set_game_status(int status) { game_status_ = status; }
 
+  /**
+   * @brief Select how entity-entity collisions are found. Both modes give the
+   * same result, kCollisionBruteForce is kept to check kCollisionGrid.
+   */
+  void set_collision_mode(CollisionMode mode) { collision_mode_ = mode; }
+  CollisionMode get_collision_mode() const { return collision_mode_; }
+
+  /**
+   * @brief Select how the robots' sensors are notified.
+   *
+   * @param mode kSenseAll, kSenseCutoff or kSenseField.
+   * @param epsilon In kSenseCutoff and kSenseField modes, the contribution
+   * below which a light or food is ignored by a sensor. Food further than
+   * the food sensing radius of the parameters is ignored too.
+   */
+  void set_sensing_mode(SensingMode mode, double epsilon);
+  SensingMode get_sensing_mode() const { return sensing_mode_; }
+
+  /**
+   * @brief Distances beyond which the sensors ignore a light or a food.
+   */
+  double get_light_cutoff() const { return light_cutoff_; }
+  double get_food_cutoff() const { return food_cutoff_; }
+
+  /**
+   * @brief Select how the sensors' response to a light or food is computed:
+   * exactly, or interpolated in a table of each sensitivity's response curve
+   * (see ResponseTable).
+   */
+  void set_response_mode(ResponseMode mode);
+  ResponseMode get_response_mode() const { return params_.response_mode; }
+
+  /**
+   * @brief Set how far a robot's food sensors may move before their
+   * readings are computed again.
+   *
+   * Food does not move, so the food readings of a robot are kept from one
+   * timestep to the next until one of its sensors is further than threshold
+   * from where they were computed, or some food moves, appears, disappears
+   * or is captured. At 0, the readings are only kept while the robot stands
+   * still, and are the same as when computed every timestep. Does not apply
+   * to kSenseField mode, whose readings are as cheap to sample as to keep.
+   */
+  void set_food_sensing_threshold(double threshold);
+  double get_food_sensing_threshold() const {
+    return params_.food_sensing_threshold;
+  }
+
+  /**
+   * @brief Select what picks the robots' wheel velocities: their motion
+   * handler's policy, or the wiring of their behaviour (see set_wirings()).
+   */
+  void set_controller_mode(ControllerMode mode) {
+    params_.controller_mode = mode;
+  }
+  ControllerMode get_controller_mode() const {
+    return params_.controller_mode;
+  }
+
+  /**
+   * @brief Set the wiring of every robot behaviour, used in kControllerWiring
+   * mode.
+   */
+  void set_wirings(const wiring_table &wirings) { params_.wirings = wirings; }
+  const wiring_table &get_wirings() const { return params_.wirings; }
+
+  size_t get_n_threads() const { return thread_pool_.get_n_threads(); }
+
+  /**
+   * @brief Turn the timing of the timestep phases on or off. Only has an
+   * effect when the instrumentation is compiled in (ARENA_PROFILING).
+   */
+  void set_profiling(bool enabled) { profiler_.set_enabled(enabled); }
+  bool is_profiling() const { return profiler_.is_enabled(); }
+
+  /**
+   * @brief The time spent in each phase of the last timestep and its counts.
+   */
+  const tick_stats &get_tick_stats() const {
+    return profiler_.get_last_tick();
+  }
+
+  TickProfiler *get_profiler() { return &profiler_; }
+
+  /**
+   * @brief Record the robots at the end of every timestep, until set back
+   * to nullptr. The Arena does not own the recorder.
+   */
+  void set_recorder(TrajectoryRecorder *recorder) { recorder_ = recorder; }
+
+  /**
+   * @brief Write the whole state of the Arena to a checkpoint: the
+   * parameters it was built with, the seed and epoch of its random streams,
+   * the game status and the state of every entity.
+   *
+   * @return false if the write failed.
+   */
+  bool SaveCheckpoint(std::ostream &out) const;
+
+  /**
+   * @brief Restore the state written by SaveCheckpoint(), so that the
+   * Arena continues exactly as the saved one would have.
+   *
+   * The Arena must hold the same entities as the saved one, which is the
+   * case when it is built from the parameters given by
+   * ReadCheckpointParams(). Its # of threads is kept.
+   *
+   * @return false if the checkpoint is truncated or of a different Arena.
+   * The Arena may then be partly restored, and should be Reset().
+   */
+  bool RestoreCheckpoint(std::istream &in);
+
+  /**
+   * @brief Read the parameters at the start of a checkpoint, to build an
+   * Arena to restore it into. params->n_threads is left unchanged.
+   *
+   * @return false if in does not start with a checkpoint.
+   */
+  static bool ReadCheckpointParams(std::istream &in, arena_params *params);
+
+  /**
+   * @brief The parameters the Arena was built with, with the seed that was
+   * drawn if none was given.
+   */
+  const arena_params &get_params() const { return params_; }
+
  private:
+  /**
+   * @brief Per-thread buffers for the grid queries, and counts of the
+   * profiler.
+   */
+  struct QueryScratch {
+    std::vector<int> ids{};
+    std::vector<double> x{};
+    std::vector<double> y{};
+    std::vector<double> radius{};
+    uint64_t counts[kCounterCount]{};
+    // Robots of each (behaviour, hunger band) controller group, and the
+    // inputs and outputs of the group being run, gathered
+    std::vector<size_t> group[kBehaviorCount][kHungerBandCount]{};
+    // Robots driven by their wiring matrix instead
+    std::vector<size_t> wired{};
+    std::vector<double> batch{};
+  };
+
+  /**
+   * @brief Size store_ for the entities, and bind entity i to row i of it.
+   * From then on the entities keep their pose, radius and velocity there.
+   */
+  void BindEntityStore();
+
+  /**
+   * @brief Name the label of each entity's draw record, from the entity
+   * names.
+   */
+  void RebuildDrawLabels();
+
+  /**
+   * @brief Fill and publish the next frame of draw_snapshot_.
+   */
+  void PublishDrawSnapshot();
+
+  /**
+   * @brief Advance the poses of store_ entities [begin, end) by one timestep
+   * according to their wheel velocities.
+   */
+  void IntegratePoses(size_t begin, size_t end);
+
+  /**
+   * @brief Compute the position of the sensors of robots [begin, end) and
+   * zero their readings and feeding flags in store_.
+   */
+  void ResetSensors(size_t begin, size_t end);
+
+  /**
+   * @brief Compute the sensor readings and feeding flag of robots
+   * [begin, end) in store_ from every light and food. The light readings of
+   * all the sensors are computed at once by SenseLights().
+   */
+  void SenseAll(size_t begin, size_t end, QueryScratch *scratch);
+
+  /**
+   * @brief Store the lights and food in light_grid_ and food_grid_ (only
+   * the food in kSenseField mode).
+   */
+  void RebuildSensingGrids();
+
+  /**
+   * @brief Same as SenseAll(), but each robot only considers the light and
+   * food within the sensing cutoff, found through light_grid_ and food_grid_.
+   */
+  void SenseUsingGrid(size_t begin, size_t end, QueryScratch *scratch);
+
+  /**
+   * @brief Rasterise again the parts of light_field_ and food_field_ that the
+   * lights and food moving changed.
+   */
+  void UpdateStimulusFields();
+
+  /**
+   * @brief Same as SenseUsingGrid(), but the light and food readings are
+   * sampled from light_field_ and food_field_.
+   */
+  void SenseUsingField(size_t begin, size_t end, QueryScratch *scratch);
+
+  /**
+   * @brief Add the contribution of the food at index source of store_ to the
+   * readings of robot r, and determine whether robot r can eat it.
+   */
+  void SenseFood(size_t r, size_t source, QueryScratch *scratch);
+
+  /**
+   * @brief Forget the food readings kept by every robot.
+   */
+  void InvalidateFoodReadings();
+
+  /**
+   * @brief Compare the food with food_signature_, and forget the food
+   * readings kept by the robots if any has changed.
+   */
+  void CheckFoodChanges();
+
+  /**
+   * @brief If the food readings that robot r kept are still valid, set its
+   * readings and feeding flag from them and return true.
+   */
+  bool ReuseFoodReadings(size_t r, QueryScratch *scratch);
+
+  /**
+   * @brief Keep the food readings of robot r, just computed.
+   */
+  void KeepFoodReadings(size_t r);
+
+  /**
+   * @brief Set whether robot r can eat, from the food found in food_grid_.
+   */
+  void SenseFeeding(size_t r, QueryScratch *scratch);
+
+  /**
+   * @brief Add the response of sensors to lights to their readings, in the
+   * current response mode, with the arguments of AccumulateLightReadings().
+   */
+  void SenseLights(size_t n_sensors, const double *sensor_x,
+    const double *sensor_y, const double *sensitivity, size_t n_lights,
+    const double *light_x, const double *light_y, const double *light_radius,
+    double *readings) const;
+
+  /**
+   * @brief A food sensor reading plus the response to food at the given
+   * distance, in the current response mode.
+   */
+  double FoodResponse(double reading, double distance) const;
+
+  /**
+   * @brief Pass the sensor readings of robots [begin, end) to the robots, and
+   * store the heading and wheel velocities their controllers pick.
+   *
+   * The robots that are neither dead nor reverse arcing are grouped by
+   * behaviour and hunger band, and each group runs through its
+   * ControllerKernel in one pass instead of calling its motion handler. In
+   * kControllerWiring mode they all go through their wiring at once.
+   */
+  void UpdateRobotControllers(size_t begin, size_t end,
+    QueryScratch *scratch);
+
+  /**
+   * @brief Run the ControllerKernel of a behaviour and hunger band on the
+   * given robots, and pass them the wheel velocities it picks.
+   *
+   * @param batch_buffer Holds the gathered inputs and outputs.
+   */
+  void RunControllerGroup(RobotType behavior, HungerBand band,
+    const std::vector<size_t> &robots, std::vector<double> *batch_buffer);
+
+  /**
+   * @brief Compute the wheel velocities of the given robots with the wiring
+   * matrix of their behaviour and hunger band, all at once, and pass them to
+   * the robots.
+   *
+   * @param batch_buffer Holds the gathered weights, inputs and outputs.
+   */
+  void RunWiredControllers(const std::vector<size_t> &robots,
+    std::vector<double> *batch_buffer);
+
+  /**
+   * @brief Call HandleCollision() on the robot or light at index i of store_.
+   */
+  void HandleCollision(size_t i);
+
+  /**
+   * @brief Move the mobile entities [begin, end) of store_ that overlap a wall
+   * back inside the Arena.
+   */
+  void ResolveWallCollisions(size_t begin, size_t end,
+    QueryScratch *scratch);
+
+  /**
+   * @brief Compute the position of the mobile entities [begin, end) after
+   * they are pushed away from the entities they overlap.
+   *
+   * Each entity is pushed away from the others in index order, starting from
+   * its own position and against the positions of the others before this
+   * phase. The results go to store_.resolved_x and store_.resolved_y, so
+   * the entities can be processed in any order, or concurrently.
+   */
+  void ResolveEntityOverlaps(size_t begin, size_t end, QueryScratch *scratch);
+
+  /**
+   * @brief Push entity i of store_ away from entity j if they are colliding
+   * and of the same type (robots bounce off robots, lights off lights).
+   * @return true if entity i was pushed.
+   */
+  bool ResolveEntityOverlap(size_t i, size_t j, QueryScratch *scratch);
+
+  /**
+   * @brief Add the counts of every thread to the profiler, and clear them.
+   */
+  void CollectCounts();
+
+  /**
+   * @brief Store every entity in the collision grid. The cell size is twice
+   * the largest radius, so colliding entities are always in adjacent cells.
+   */
+  void RebuildCollisionGrid();
+
+  /**
+   * @brief Same as the inner loop of the brute force collision check, but
+   * only visits the entities near the mobile entity.
+   *
+   * Candidates are visited in index order, and the neighbourhood is queried
+   * again each time the mobile entity is pushed away, so the result is
+   * identical to the brute force loop.
+   *
+   * @param index The index of the mobile entity within store_.
+   */
+  void ResolveEntityOverlapUsingGrid(size_t index, QueryScratch *scratch);
+
+  /**
+   * @brief Create the entities given by params_, and set the sensing and
+   * response modes it asks for.
+   */
+  void AddEntities();
+
+  // Parameters of the Arena, saved in checkpoints
+  arena_params params_;
+
   // Dimensions of graphics window inside which entities must operate
   double x_dim_;
   double y_dim_;
 
-  // Used to create all entities within the arena
+  // Every random decision of the arena is drawn from a stream of rng_, and
+  // epoch_ counts the resets so that each reset draws from fresh streams.
+  Rng rng_;
+  uint32_t epoch_{0};
+
+  // Used to create all entities within the arena, and owns them
   EntityFactory *factory_;
 
   // Robot is special. It's also stored in the robot array.
-  Robot *robot_[N_ROBOTS];
+  std::vector<Robot *> robot_;
   // Light is special. It's also stored in the light array.
-  Light *light_[N_LIGHTS];
+  std::vector<Light *> light_;
 
   // All entities mobile and immobile.
   std::vector<class ArenaEntity *> entities_;
 
   // A subset of the entities -- only those that can move (only Robot for now).
   std::vector<class ArenaMobileEntity *> mobile_entities_;
+  // Food is stored in the food array, after the robots and lights.
+  std::vector<Food *> food_;
+
+  // Per-entity state, laid out robots, lights, food like entities_. The
+  // entities read and write their own row.
+  EntityStore store_;
+
+  // Broadphase used to find entity-entity collisions
+  CollisionMode collision_mode_{kCollisionGrid};
+  SpatialGrid collision_grid_;
+  // Half-size of the neighbourhood queried in the collision grid
+  double collision_reach_{0};
+
+  // How sensors are notified
+  SensingMode sensing_mode_{kSenseAll};
+  // Sensitivity of the robots' light sensors
+  double light_sensitivity_{1.08};
+  // Distances beyond which light and food are ignored by sensors
+  double light_cutoff_{0};
+  double food_cutoff_{0};
+  // Response curves of the light and food sensors, for kResponseTable mode
+  ResponseTable light_table_;
+  ResponseTable food_table_;
+  // Position, radius and captured flag of each food when the robots' food
+  // readings were last checked, see CheckFoodChanges()
+  std::vector<double> food_signature_;
+  // Lights and food, by index within store_, for the cutoff sensing mode
+  SpatialGrid light_grid_;
+  SpatialGrid food_grid_;
+  double max_light_radius_{0};
+  double max_food_radius_{0};
+  // Responses to the lights and food, for the field sensing mode
+  StimulusField light_field_;
+  StimulusField food_field_;
+
+  // Runs the phases of a timestep
+  ThreadPool thread_pool_;
+  // Scratch buffers of each thread of thread_pool_
+  std::vector<QueryScratch> scratch_;
+  // Times the phases of the timestep, when compiled in
+  TickProfiler profiler_;
+  // Records the robots at every timestep, if set
+  TrajectoryRecorder *recorder_{nullptr};
+  // What the viewer draws, and the label of each entity in it
+  DrawSnapshot own_draw_snapshot_;
+  DrawSnapshot *draw_snapshot_;
+  std::vector<uint32_t> draw_label_;
+  std::shared_ptr<const std::vector<std::string>> draw_labels_;
+  double draw_tile_size_{0};
 
   // win/lose/playing state
   int game_status_;
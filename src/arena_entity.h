@@ -10,13 +10,17 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <iostream>
 #include <string>
 
+#include "src/binary_io.h"
 #include "src/common.h"
+#include "src/entity_store.h"
 #include "src/entity_type.h"
 #include "src/params.h"
 #include "src/pose.h"
 #include "src/rgb_color.h"
+#include "src/rng.h"
 
 /*******************************************************************************
  * Namespaces
@@ -43,6 +47,9 @@ NAMESPACE_BEGIN(csci3081);
  *
  * All arena entities are circular.
  *
+ * Once an entity is placed in an Arena, its pose and radius live in its row
+ * of the Arena's EntityStore, and the accessors below read and write that
+ * row. An entity that is not in an Arena keeps them itself.
  */
 class ArenaEntity {
  public:
@@ -56,6 +63,25 @@ class ArenaEntity {
    */
   virtual ~ArenaEntity() = default;
 
+  ArenaEntity(const ArenaEntity &other) = delete;
+  ArenaEntity &operator=(const ArenaEntity &other) = delete;
+
+  /**
+   * @brief Keep the state of the entity in row of store from now on. The
+   * current state is moved there.
+   *
+   * Subclasses with more state in the store move it after the state of their
+   * base.
+   */
+  virtual void BindStore(EntityStore *store, size_t row) {
+    Pose pose = get_pose();
+    double radius = get_radius();
+    store_ = store;
+    row_ = row;
+    set_pose(pose);
+    set_radius(radius);
+  }
+
   /**
    * @brief Perform whatever updates needed for a particular entity after 1
    * timestep (updating position, changing color, etc.).
@@ -66,8 +92,51 @@ class ArenaEntity {
 
   /**
    * @brief Reset entity to a newly constructed state.
+   *
+   * @param random The stream from which the entity draws its new random
+   * state.
    */
-  virtual void Reset() {}
+  virtual void Reset(__unused RandomStream *random) {}
+
+  /**
+   * @brief Write the state of the entity to a checkpoint of the Arena.
+   *
+   * Subclasses with more state write it after the state of their base.
+   */
+  virtual void SaveState(std::ostream &out) const {
+    WriteValue(out, static_cast<int32_t>(type_));
+    WriteValue(out, static_cast<int32_t>(id_));
+    Pose pose = get_pose();
+    WriteValue(out, pose.x);
+    WriteValue(out, pose.y);
+    WriteValue(out, pose.theta);
+    WriteValue(out, get_radius());
+    WriteValue(out, static_cast<int32_t>(color_.r));
+    WriteValue(out, static_cast<int32_t>(color_.g));
+    WriteValue(out, static_cast<int32_t>(color_.b));
+  }
+
+  /**
+   * @brief Read back the state written by SaveState().
+   *
+   * @return false if the checkpoint ended, or was written by another entity.
+   */
+  virtual bool LoadState(std::istream &in) {
+    int32_t type = 0, id = 0, r = 0, g = 0, b = 0;
+    Pose pose;
+    double radius = 0;
+    if (!ReadValue(in, &type) || !ReadValue(in, &id) ||
+        type != static_cast<int32_t>(type_) || id != id_ ||
+        !ReadValue(in, &pose.x) || !ReadValue(in, &pose.y) ||
+        !ReadValue(in, &pose.theta) || !ReadValue(in, &radius) ||
+        !ReadValue(in, &r) || !ReadValue(in, &g) || !ReadValue(in, &b)) {
+      return false;
+    }
+    set_pose(pose);
+    set_radius(radius);
+    color_ = RgbColor(r, g, b);
+    return true;
+  }
 
   /**
    * @brief Get the name of the entity for visualization and for debugging.
@@ -78,24 +147,44 @@ class ArenaEntity {
   virtual std::string get_name() const = 0;
 
 
-  const Pose &get_pose() const { return pose_; }
+  Pose get_pose() const {
+    if (store_) {
+      return Pose(store_->x[row_], store_->y[row_], store_->theta[row_]);
+    }
+    return pose_;
+  }
+
   /**
    * @brief Setter method for position within entity pose variable.
    */
-  void set_pose(const Pose &pose) { pose_ = pose; }
+  void set_pose(const Pose &pose) {
+    set_position(pose.x, pose.y);
+    set_heading(pose.theta);
+  }
 
   /**
    * @brief Setter method for position within entity pose variable.
    */
   void set_position(const double inx, const double iny) {
-    pose_.x = inx;
-    pose_.y = iny;
+    if (store_) {
+      store_->x[row_] = inx;
+      store_->y[row_] = iny;
+    } else {
+      pose_.x = inx;
+      pose_.y = iny;
+    }
   }
 
   /**
    * @brief Setter method for heading within entity pose variable.
    */
-  void set_heading(const double t) {pose_.theta = t;}
+  void set_heading(const double t) {
+    if (store_) {
+      store_->theta[row_] = t;
+    } else {
+      pose_.theta = t;
+    }
+  }
 
   /**
    * @brief Setter for heading within pose, but change is relative to current
@@ -105,16 +194,24 @@ class ArenaEntity {
    * or negative.
    */
   void RelativeChangeHeading(const double delta) {
-    pose_.theta += delta;
+    set_heading(get_pose().theta + delta);
   }
 
   const RgbColor &get_color() const { return color_; }
 
   void set_color(const RgbColor &color) { color_ = color; }
 
-  double get_radius() const { return radius_; }
+  double get_radius() const {
+    return (store_) ? store_->radius[row_] : radius_;
+  }
 
-  void set_radius(double radius) { radius_ = radius; }
+  void set_radius(double radius) {
+    if (store_) {
+      store_->radius[row_] = radius;
+    } else {
+      radius_ = radius;
+    }
+  }
 
   EntityType get_type() const { return type_; }
   void set_type(EntityType et) { type_ = et; }
@@ -133,6 +230,18 @@ class ArenaEntity {
    */
   void set_mobility(bool value) { is_mobile_ = value; }
 
+ protected:
+  /**
+   * @brief The store that holds the state of the entity, or nullptr if the
+   * entity keeps it itself.
+   */
+  EntityStore *get_store() const { return store_; }
+
+  /**
+   * @brief The row of the entity in get_store().
+   */
+  size_t get_store_row() const { return row_; }
+
  private:
   // radius of entity
   double radius_{DEFAULT_RADIUS};
@@ -146,6 +255,9 @@ class ArenaEntity {
   int id_{-1};
   // mobility
   bool is_mobile_{false};
+  // where the pose and radius are kept, see BindStore()
+  EntityStore *store_{nullptr};
+  size_t row_{0};
 };
 
 NAMESPACE_END(csci3081);
@@ -14,7 +14,7 @@
 
 #include "src/arena_entity.h"
 #include "src/common.h"
-
+#include "src/wheel_velocity.h"
 
 /*******************************************************************************
  * Namespaces
@@ -49,12 +49,55 @@ class ArenaMobileEntity : public ArenaEntity {
   ArenaMobileEntity& operator=(const ArenaMobileEntity& other) = delete;
 
 
+  /**
+   * @brief Move the wheel velocities to the store along with the pose.
+   */
+  void BindStore(EntityStore *store, size_t row) override {
+    WheelVelocity velocity = get_velocity();
+    ArenaEntity::BindStore(store, row);
+    set_velocity(velocity.left, velocity.right);
+  }
+
+  /**
+   * @brief The wheel velocities, which the motion handler sets and the
+   * motion behavior moves the entity by.
+   */
+  WheelVelocity get_velocity() const {
+    const EntityStore *store = get_store();
+    if (store) {
+      size_t row = get_store_row();
+      return WheelVelocity(store->vel_left[row], store->vel_right[row]);
+    }
+    return velocity_;
+  }
+
+  void set_velocity(double left, double right) {
+    EntityStore *store = get_store();
+    if (store) {
+      store->vel_left[get_store_row()] = left;
+      store->vel_right[get_store_row()] = right;
+    } else {
+      velocity_ = WheelVelocity(left, right);
+    }
+  }
+
   virtual double get_speed() { return speed_; }
   virtual void set_speed(double sp) { speed_ = sp; }
 
+  void SaveState(std::ostream &out) const override {
+    ArenaEntity::SaveState(out);
+    WriteValue(out, speed_);
+  }
+
+  bool LoadState(std::istream &in) override {
+    return ArenaEntity::LoadState(in) && ReadValue(in, &speed_);
+  }
+
  private:
   // the speed of the entity
   double speed_;
+  // wheel velocities, kept here until BindStore()
+  WheelVelocity velocity_{0, 0};
 };
 
 NAMESPACE_END(csci3081);
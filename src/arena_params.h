@@ -11,9 +11,16 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <cstdint>
+
+#include "src/collision_mode.h"
 #include "src/common.h"
+#include "src/controller_mode.h"
 #include "src/light.h"
 #include "src/params.h"
+#include "src/response_mode.h"
+#include "src/sensing_mode.h"
+#include "src/wiring.h"
 
 /*******************************************************************************
  * Namespaces
@@ -38,6 +45,20 @@ struct arena_params {
   uint x_dim{ARENA_X_DIM};
   uint y_dim{ARENA_Y_DIM};
   bool food_on{true};
+  CollisionMode collision_mode{kCollisionGrid};
+  SensingMode sensing_mode{kSenseAll};
+  double sensing_epsilon{SENSING_EPSILON};
+  double food_sensing_radius{FOOD_SENSING_RADIUS};
+  ResponseMode response_mode{kResponseExact};
+  double field_cell_size{FIELD_CELL_SIZE};
+  double food_sensing_threshold{FOOD_SENSING_THRESHOLD};
+  ControllerMode controller_mode{kControllerPolicy};
+  // wiring of each robot behaviour, used by kControllerWiring
+  wiring_table wirings{DefaultWirings()};
+  // threads running each timestep, including the calling thread
+  size_t n_threads{1};
+  // seed of the random placement of the entities, 0 for a random seed
+  uint32_t seed{0};
 };
 
 NAMESPACE_END(csci3081);
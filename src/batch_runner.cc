@@ -0,0 +1,98 @@
+/**
+ * @file batch_runner.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <vector>
+
+#include "src/batch_runner.h"
+#include "src/robot.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+BatchRunner::BatchRunner(const arena_params &params)
+    : params_(params), arena_(&params) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void BatchRunner::Reconfigure(const arena_params &params) {
+  params_ = params;
+  arena_.Reconfigure(&params);
+} /* Reconfigure() */
+
+run_summary BatchRunner::Run(int max_ticks) {
+  run_summary summary;
+  auto start = std::chrono::steady_clock::now();
+  while (summary.ticks < max_ticks && arena_.get_game_status() == PLAYING) {
+    arena_.UpdateEntitiesTimestep();
+    summary.ticks++;
+  }
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+  summary.seconds = elapsed.count();
+  summary.status = arena_.get_game_status();
+
+  int n_robots = 0;
+  double total_hunger = 0;
+  for (auto ent : arena_.get_entities()) {
+    if (ent->get_type() != kRobot) {
+      continue;
+    }
+    int hunger = dynamic_cast<Robot *>(ent)->get_hungry_counter();
+    n_robots++;
+    total_hunger += hunger;
+    summary.max_hunger = std::max(summary.max_hunger, hunger);
+    if (hunger >= HUNGRY) {
+      summary.n_hungry++;
+    }
+    if (hunger >= STARVE) {
+      summary.n_starving++;
+    }
+  }
+  if (n_robots > 0) {
+    summary.mean_hunger = total_hunger / n_robots;
+  }
+  return summary;
+} /* Run() */
+
+std::string BatchRunner::CheckParams(const arena_params &params) {
+  std::ostringstream error;
+  if (params.n_ratio > 100) {
+    error << "the ratio of fearful robots is a percentage";
+  } else if (params.n_threads == 0) {
+    error << "at least one thread is needed";
+  }
+  return error.str();
+} /* CheckParams() */
+
+void BatchRunner::WriteCsvHeader(std::ostream &out) {
+  out << "seed,n_robots,n_lights,n_food,n_ratio,n_light_sensitivity,food_on,"
+      << "status,ticks,n_hungry,n_starving,mean_hunger,max_hunger,seconds\n";
+} /* WriteCsvHeader() */
+
+void BatchRunner::WriteCsvRow(std::ostream &out, const arena_params &params,
+  const run_summary &summary) {
+  out << params.seed << ',' << params.n_robots << ',' << params.n_lights
+      << ',' << params.n_food << ',' << params.n_ratio << ',' << params.n_light_sensitivity << ','
+      << (params.food_on ? 1 : 0) << ','
+      << (summary.status == LOST ? "lost" : "playing") << ','
+      << summary.ticks << ',' << summary.n_hungry << ','
+      << summary.n_starving << ',' << summary.mean_hunger << ','
+      << summary.max_hunger << ',' << summary.seconds << '\n';
+} /* WriteCsvRow() */
+
+NAMESPACE_END(csci3081);
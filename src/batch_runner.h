@@ -0,0 +1,108 @@
+/**
+ * @file batch_runner.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_BATCH_RUNNER_H_
+#define SRC_BATCH_RUNNER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <iostream>
+#include <string>
+
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief Statistics collected at the end of a headless run.
+ */
+struct run_summary {
+  // PLAYING if the run reached its tick limit, LOST if a robot starved
+  int status{PLAYING};
+  // timesteps simulated; the survival time when status is LOST
+  int ticks{0};
+  // robots at least HUNGRY / STARVE timesteps away from their last meal
+  int n_hungry{0};
+  int n_starving{0};
+  // hungry counters of the robots at the end of the run
+  double mean_hunger{0};
+  int max_hunger{0};
+  // wall clock time of the run
+  double seconds{0};
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Runs an Arena without any graphics, as fast as the CPU allows.
+ *
+ * The runner only depends on the model, so it can be linked into
+ * executables that do not link MinGfx, nanogui or OpenGL.
+ */
+class BatchRunner {
+ public:
+  /**
+   * @brief Constructor. Creates the Arena from params.
+   *
+   * params must have been accepted by CheckParams().
+   */
+  explicit BatchRunner(const arena_params &params);
+
+  BatchRunner(const BatchRunner& other) = delete;
+  BatchRunner& operator=(const BatchRunner& other) = delete;
+
+  /**
+   * @brief Advance the Arena until a robot starves or max_ticks timesteps
+   * have been simulated.
+   *
+   * @return The statistics of the run.
+   */
+  run_summary Run(int max_ticks);
+
+  /**
+   * @brief Reconfigure the Arena in place for another run with params,
+   * which must have been accepted by CheckParams().
+   */
+  void Reconfigure(const arena_params &params);
+
+  Arena *get_arena() { return &arena_; }
+
+  /**
+   * @brief Determine whether an Arena can be built from params.
+   *
+   * @return An empty string if it can, what is wrong otherwise.
+   */
+  static std::string CheckParams(const arena_params &params);
+
+  /**
+   * @brief Write the column names matching WriteCsvRow().
+   */
+  static void WriteCsvHeader(std::ostream &out);
+
+  /**
+   * @brief Write the parameters and statistics of a run as one CSV line.
+   */
+  static void WriteCsvRow(std::ostream &out, const arena_params &params,
+    const run_summary &summary);
+
+ private:
+  arena_params params_;
+  Arena arena_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_BATCH_RUNNER_H_
@@ -0,0 +1,101 @@
+/**
+ * @file binary_io.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_BINARY_IO_H_
+#define SRC_BINARY_IO_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/*
+ * Helpers for the binary files of the simulation. Values are written in the
+ * byte order of the machine, so files are only read back on machines of the
+ * same endianness (every platform the simulator supports is little-endian).
+ */
+
+/**
+ * @brief Write the bytes of value to out.
+ */
+template <typename T>
+void WriteValue(std::ostream &out, const T &value) {
+  static_assert(std::is_trivially_copyable<T>::value,
+    "only plain values can be written");
+  out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/**
+ * @brief Write n values starting at values to out.
+ */
+template <typename T>
+void WriteValues(std::ostream &out, const T *values, size_t n) {
+  static_assert(std::is_trivially_copyable<T>::value,
+    "only plain values can be written");
+  out.write(reinterpret_cast<const char *>(values),
+            static_cast<std::streamsize>(n * sizeof(T)));
+}
+
+/**
+ * @brief Read a value from the buffer [*cursor, end), and advance *cursor
+ * past it. The buffer does not need to be aligned.
+ *
+ * @return false, leaving *value unchanged, if the buffer is too short.
+ */
+template <typename T>
+bool ReadValue(const char **cursor, const char *end, T *value) {
+  static_assert(std::is_trivially_copyable<T>::value,
+    "only plain values can be read");
+  if (end - *cursor < static_cast<std::ptrdiff_t>(sizeof(T))) {
+    return false;
+  }
+  std::memcpy(value, *cursor, sizeof(T));
+  *cursor += sizeof(T);
+  return true;
+}
+
+/**
+ * @brief Read a value from the stream in.
+ *
+ * @return false if the stream ended first.
+ */
+template <typename T>
+bool ReadValue(std::istream &in, T *value) {
+  static_assert(std::is_trivially_copyable<T>::value,
+    "only plain values can be read");
+  in.read(reinterpret_cast<char *>(value), sizeof(T));
+  return static_cast<bool>(in);
+}
+
+/**
+ * @brief Read n values from the stream in.
+ *
+ * @return false if the stream ended first.
+ */
+template <typename T>
+bool ReadValues(std::istream &in, T *values, size_t n) {
+  static_assert(std::is_trivially_copyable<T>::value,
+    "only plain values can be read");
+  in.read(reinterpret_cast<char *>(values),
+          static_cast<std::streamsize>(n * sizeof(T)));
+  return static_cast<bool>(in);
+}
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_BINARY_IO_H_
@@ -0,0 +1,31 @@
+/**
+ * @file collision_mode.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_COLLISION_MODE_H_
+#define SRC_COLLISION_MODE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/**
+ * kCollisionBruteForce tests every mobile entity against every entity.
+ * kCollisionGrid only tests the entities found in the neighbouring cells of
+ * a uniform grid. Both produce the same result.
+ */
+enum CollisionMode {
+  kCollisionBruteForce, kCollisionGrid
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_COLLISION_MODE_H_
@@ -28,6 +28,11 @@ enum Communication {
   kNewGame,
   kFoodOn,
   kFoodOff,
+  kFastForwardOn,
+  kFastForwardOff,
+  kProfileOn,
+  kProfileOff,
+  kSpeed,   // the speed multiplier comes with it, see simulation_command
 
   // communications from controller to Arena
   kReset,
@@ -8,6 +8,8 @@
  * Includes
  ******************************************************************************/
 #include <nanogui/nanogui.h>
+#include <algorithm>
+#include <memory>
 #include <string>
 #include "src/arena_params.h"
 #include "src/common.h"
@@ -18,37 +20,74 @@
  ******************************************************************************/
 NAMESPACE_BEGIN(csci3081);
 
-Controller::Controller() : last_dt(0) {
+Controller::Controller() {
   // Initialize default properties for various arena entities
   arena_params aparams;
   aparams.x_dim = ARENA_X_DIM;
   aparams.y_dim = ARENA_Y_DIM;
 
-  arena_ = new Arena(&aparams);
+  simulation_ = new SimulationThread(new Arena(&aparams));
 
-  // Start up the graphics (which creates the arena).
+  // Start up the graphics.
   // Run() will enter the nanogui::mainloop().
-  viewer_ = new GraphicsArenaViewer(&aparams, arena_, this);
+  viewer_ = new GraphicsArenaViewer(&aparams, this);
 }
 
-void Controller::Run() { viewer_->Run(); }
+Controller::~Controller() { delete simulation_; }
+
+void Controller::Run() {
+  simulation_->Start();
+  viewer_->Run();
+  simulation_->Stop();
+}
 
 void Controller::AdvanceTime(double dt) {
-  if ((last_dt + dt) <= .05) {
-    last_dt += dt;
+  if (!is_replaying()) {
+    return;
+  }
+  int ticks = clock_.TicksDue(dt);
+  if (ticks <= 0) {
     return;
   }
-  last_dt = 0;
-  arena_->AdvanceTime(dt);
+  // Playing back costs nothing per tick, and stops at the last one
+  replay_tick_ = std::min(replay_tick_ + static_cast<uint64_t>(ticks),
+                          replay_.get_n_ticks() - 1);
+  clock_.RecordTicks(ticks, 0);
+}
+
+void Controller::set_speed(double multiplier) {
+  clock_.set_multiplier(multiplier);
+  simulation_command command;
+  command.com = kSpeed;
+  command.value = multiplier;
+  simulation_->Post(command);
+}
+
+void Controller::set_fast_forward(bool fast_forward) {
+  clock_.set_fast_forward(fast_forward);
+  simulation_->Post(fast_forward ? kFastForwardOn : kFastForwardOff);
+}
+
+bool Controller::OpenReplay(const std::string &path) {
+  if (!replay_.Open(path) || replay_.get_n_ticks() == 0) {
+    replay_.Close();
+    return false;
+  }
+  replay_tick_ = 0;
+  clock_.Reset();
+  return true;
 }
 
 void Controller::AcceptCommunication(Communication com) {
-  arena_->AcceptCommand(ConvertComm(com));
+  if (kPlay == com || kPause == com) {
+    clock_.Reset();
+  }
+  simulation_->Post(ConvertComm(com));
 }
 
 void Controller::Reset() {
-  // delete the original arena
-  delete arena_;
+  // a new game is simulated, even after a replay
+  replay_.Close();
 
   /*
    * initialize a new params to store the new features for the arena to be
@@ -67,8 +106,12 @@ void Controller::Reset() {
   aparams.n_ratio = viewer_->get_ratio();
   aparams.food_on = viewer_->is_food_on();
 
-  // create new arena
-  arena_ = new Arena(&aparams);
+  // the simulation thread replaces its arena by a new one
+  simulation_command command;
+  command.com = kNewGame;
+  command.params = std::make_shared<const arena_params>(aparams);
+  simulation_->Post(command);
+  clock_.Reset();
 }
 
 
@@ -84,6 +127,8 @@ Communication Controller::ConvertComm(Communication com) {
     case (kNewGame) : Reset();
     case (kFoodOff) : return kFoodOff;
     case (kFoodOn) : return kFoodOn;
+    case (kProfileOn) : return kProfileOn;
+    case (kProfileOff) : return kProfileOff;
     default: return kNone;
   }
 }
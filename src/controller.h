@@ -18,6 +18,9 @@
 #include "src/communication.h"
 #include "src/graphics_arena_viewer.h"
 #include "src/params.h"
+#include "src/simulation_clock.h"
+#include "src/simulation_thread.h"
+#include "src/trajectory_reader.h"
 
 /*******************************************************************************
  * Namespaces
@@ -33,8 +36,9 @@ class GraphicsArenaViewer;
  * @brief Controller that mediates Arena and GraphicsArenaViewer communication.
  *
  * The Controller instantiates the Arena and the GraphicsArenaViewer. The
- * viewer contains the main loop that keeps it live, but at each update, the
- * viewer sends a message to the controller to update its time.
+ * viewer contains the main loop that keeps it live, while the Arena runs on
+ * a SimulationThread of its own, started by Run(). The viewer draws the
+ * frames the Arena publishes, and its commands are queued for the Arena.
  *
  * Other types of communication between Arena and Viewer include:
  * - keypresses intercepted by the Viewer.
@@ -48,18 +52,26 @@ class Controller {
    */
   Controller();
 
+  /**
+   * @brief Destructor. Stops the simulation thread and deletes the Arena.
+   */
+  ~Controller();
+
+  Controller(const Controller &other) = delete;
+  Controller &operator=(const Controller &other) = delete;
 
   /**
-   * @brief Run launches the graphics and starts the game.
+   * @brief Run starts the simulation thread, then launches the graphics and
+   * returns when the window is closed.
    */
   void Run();
 
   /**
-   * @brief AdvanceTime is communication from the Viewer to advance the
-   * simulation.
-   * @param dt The # of steps to increment by. This is
-   * practically unused because the arena state is advanced
-   * incrementally at a fixed rate.
+   * @brief AdvanceTime is communication from the Viewer at each frame. It
+   * only advances the recording played back, if any: the Arena runs on the
+   * simulation thread.
+   * @param dt The wall clock seconds since the previous frame. The clock
+   * turns it into a number of fixed timesteps.
    */
   void AdvanceTime(double dt);
 
@@ -83,15 +95,42 @@ class Controller {
   */
   Communication ConvertComm(Communication com);
 
-  Arena* getArena() {return arena_ ;}
+  /**
+   * @brief The frames published by the Arena, for the viewer to draw.
+   */
+  DrawSnapshot *get_draw_snapshot() { return simulation_->get_snapshot(); }
+
+  /**
+   * @brief The clock of the recording played back. set_speed() and
+   * set_fast_forward() change the speed of both the playback and the
+   * simulation.
+   */
+  const SimulationClock* get_clock() const { return &clock_; }
+  void set_speed(double multiplier);
+  void set_fast_forward(bool fast_forward);
+
+  /**
+   * @brief Play back a file written by TrajectoryRecorder instead of
+   * running the Arena, until the next new game.
+   *
+   * @return false if the file cannot be read.
+   */
+  bool OpenReplay(const std::string &path);
+
+  bool is_replaying() const { return replay_.is_open(); }
+  TrajectoryReader* get_replay() { return &replay_; }
+  uint64_t get_replay_tick() const { return replay_tick_; }
 
  private:
-  // counter to advance the simulation
-  double last_dt{0};
-  // arena pointer
-  Arena* arena_{nullptr};
+  // decides how many timesteps of the recording to play at each frame
+  SimulationClock clock_{};
+  // runs the arena
+  SimulationThread* simulation_{nullptr};
   // graphics arena viewer pointer
   GraphicsArenaViewer* viewer_{nullptr};
+  // recording played back, and the tick shown
+  TrajectoryReader replay_{};
+  uint64_t replay_tick_{0};
 };
 
 NAMESPACE_END(csci3081);
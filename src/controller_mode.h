@@ -0,0 +1,32 @@
+/**
+ * @file controller_mode.h
+ *
+ * @copyright 2018 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_CONTROLLER_MODE_H_
+#define SRC_CONTROLLER_MODE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/**
+ * kControllerPolicy drives the robots with the policy of their motion
+ * handler (see robot_policy.h).
+ * kControllerWiring drives them with the wiring matrix of their behaviour
+ * and hunger band (see wiring.h), which can be changed without recompiling.
+ */
+enum ControllerMode {
+  kControllerPolicy, kControllerWiring
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_CONTROLLER_MODE_H_
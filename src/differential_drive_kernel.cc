@@ -0,0 +1,117 @@
+/**
+ * @file differential_drive_kernel.cc
+ *
+ * @copyright 2018 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+
+#include "src/differential_drive_kernel.h"
+#include "src/simd.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/* sin(x) and cos(x). x is split into q * pi/2 + r with |r| <= pi/4, pi/2 in
+ * three parts so that q * pi/2 is exact for |q| below 2^29. sin(r) and
+ * cos(r) come from the minimax polynomials of the Cephes library, then the
+ * quadrant q mod 4 swaps and negates them.
+ */
+static inline void SinCos(Vec x, Vec *sin_x, Vec *cos_x) {
+  const Vec round = Set1(kRoundingShift);
+  Vec rounded = Add(Mul(x, Set1(M_2_PI)), round);
+  Vec q = Sub(rounded, round);
+  Vec r = Sub(x, Mul(q, Set1(1.5707962512969971)));
+  r = Sub(r, Mul(q, Set1(7.549789415861596e-08)));
+  r = Sub(r, Mul(q, Set1(5.390302858158119e-15)));
+  Vec r2 = Mul(r, r);
+
+  Vec s = Set1(1.58962301576546568060e-10);
+  s = Add(Mul(s, r2), Set1(-2.50507477628578072866e-8));
+  s = Add(Mul(s, r2), Set1(2.75573136213857245213e-6));
+  s = Add(Mul(s, r2), Set1(-1.98412698295895385996e-4));
+  s = Add(Mul(s, r2), Set1(8.33333333332211858878e-3));
+  s = Add(Mul(s, r2), Set1(-1.66666666666666307295e-1));
+  s = Add(r, Mul(Mul(r, r2), s));
+
+  Vec c = Set1(-1.13585365213876817300e-11);
+  c = Add(Mul(c, r2), Set1(2.08757008419747316778e-9));
+  c = Add(Mul(c, r2), Set1(-2.75573141792967388112e-7));
+  c = Add(Mul(c, r2), Set1(2.48015872888517045348e-5));
+  c = Add(Mul(c, r2), Set1(-1.38888888888730564116e-3));
+  c = Add(Mul(c, r2), Set1(4.16666666666665929218e-2));
+  c = Add(Sub(Set1(1), Mul(Set1(0.5), r2)), Mul(Mul(r2, r2), c));
+
+  // Odd quadrants swap sin and cos. sin is negated in quadrants 2 and 3,
+  // cos in quadrants 1 and 2: bit 1 of q and of q + 1, moved to the sign.
+  Vec swap = NegInt(And(rounded, SetBits(1)));
+  const Vec sign = Set1(-0.0);
+  *sin_x = Xor(Select(swap, c, s), And(ShiftLeftInt(rounded, 62), sign));
+  *cos_x = Xor(Select(swap, s, c),
+    And(ShiftLeftInt(AddInt(rounded, 1), 62), sign));
+}
+
+/* One step of kLanes entities */
+static void IntegrateBlock(double dt, const double *vel_left,
+  const double *vel_right, double *x, double *y, double *theta) {
+  Vec left = Load(vel_left);
+  Vec right = Load(vel_right);
+  Vec dt_v = Set1(dt);
+  Vec u = Mul(Sub(left, right), dt_v);
+
+  // sin(u) / u, and 1 where u is 0: the straight line case
+  Vec sin_u, cos_u;
+  SinCos(u, &sin_u, &cos_u);
+  Vec turning = Greater(Abs(u), Set1(0));
+  Vec sinc = Select(turning, Div(sin_u, Select(turning, u, Set1(1))),
+    Set1(1));
+  Vec distance = Mul(Mul(Mul(Set1(0.5), Add(left, right)), dt_v), sinc);
+
+  Vec heading = Load(theta);
+  Vec sin_h, cos_h;
+  // deg2rad(theta), operation for operation
+  Vec radians = Div(Mul(heading, Set1(M_PI)), Set1(180.0));
+  SinCos(Add(radians, u), &sin_h, &cos_h);
+  Store(x, Add(Load(x), Mul(distance, cos_h)));
+  Store(y, Add(Load(y), Mul(distance, sin_h)));
+  Store(theta, Add(heading, Add(u, u)));
+}
+
+void IntegrateDifferentialDrive(size_t n, double dt, const double *vel_left,
+  const double *vel_right, double *x, double *y, double *theta) {
+  size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    IntegrateBlock(dt, vel_left + i, vel_right + i, x + i, y + i, theta + i);
+  }
+  if (i == n) {
+    return;
+  }
+
+  // The last, padded block (see simd.h)
+  double left[kLanes] = {0};
+  double right[kLanes] = {0};
+  double px[kLanes] = {0};
+  double py[kLanes] = {0};
+  double heading[kLanes] = {0};
+  size_t n_left = n - i;
+  std::copy(vel_left + i, vel_left + n, left);
+  std::copy(vel_right + i, vel_right + n, right);
+  std::copy(x + i, x + n, px);
+  std::copy(y + i, y + n, py);
+  std::copy(theta + i, theta + n, heading);
+  IntegrateBlock(dt, left, right, px, py, heading);
+  std::copy(px, px + n_left, x + i);
+  std::copy(py, py + n_left, y + i);
+  std::copy(heading, heading + n_left, theta + i);
+}
+
+NAMESPACE_END(csci3081);
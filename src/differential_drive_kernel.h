@@ -0,0 +1,58 @@
+/**
+ * @file differential_drive_kernel.h
+ *
+ * @copyright 2018 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_DIFFERENTIAL_DRIVE_KERNEL_H_
+#define SRC_DIFFERENTIAL_DRIVE_KERNEL_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Advance the poses of many entities by one differential drive step.
+ *
+ * This is the model of MotionBehaviorDifferential, for a whole array of
+ * entities at once. With u = (vel_left - vel_right) * dt, an entity turns by
+ * 2u radians, and moves along the chord of its arc:
+ *
+ *   d      = (vel_left + vel_right) / 2 * dt * sin(u) / u
+ *   x'     = x + d * cos(theta + u)
+ *   y'     = y + d * sin(theta + u)
+ *   theta' = theta + 2u
+ *
+ * which is the rotation about the Instantaneous Center of Curvature. As u
+ * goes to 0, sin(u) / u goes to 1 and this becomes the straight line case,
+ * so both cases share the same computation and no entity branches. sin and
+ * cos are polynomials, evaluated several entities at a time (see simd.h).
+ *
+ * theta is in degrees, as in Pose; the turn is added to it in radians, as
+ * MotionBehaviorDifferential always did.
+ *
+ * @param n The number of entities.
+ * @param dt Elapsed time interval.
+ * @param vel_left The left wheel velocity of each entity.
+ * @param vel_right The right wheel velocity of each entity.
+ * @param[in,out] x The x position of each entity.
+ * @param[in,out] y The y position of each entity.
+ * @param[in,out] theta The heading of each entity.
+ */
+void IntegrateDifferentialDrive(size_t n, double dt, const double *vel_left,
+  const double *vel_right, double *x, double *y, double *theta);
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_DIFFERENTIAL_DRIVE_KERNEL_H_
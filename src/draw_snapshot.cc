@@ -0,0 +1,75 @@
+/**
+ * @file draw_snapshot.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+
+#include "src/draw_snapshot.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+void BuildDrawTiles(double x_dim, double y_dim, double tile_size,
+                    draw_frame *frame) {
+  frame->tile_size = tile_size;
+  frame->tile_cols = std::max(1,
+    static_cast<int>(std::ceil(x_dim / tile_size)));
+  frame->tile_rows = std::max(1,
+    static_cast<int>(std::ceil(y_dim / tile_size)));
+  const std::vector<draw_record> &records = frame->records;
+  std::vector<draw_tile> &tiles = frame->tiles;
+  tiles.assign(static_cast<size_t>(frame->tile_cols) * frame->tile_rows,
+    draw_tile());
+
+  // Count the records of each tile, summing their colours in the meantime,
+  // then place them with a counting sort
+  std::vector<uint32_t> tile_of(records.size());
+  std::vector<uint32_t> sums(3 * tiles.size(), 0);
+  frame->max_radius = 0;
+  for (size_t i = 0; i < records.size(); i++) {
+    const draw_record &record = records[i];
+    int col = std::min(std::max(static_cast<int>(record.x / tile_size), 0),
+      frame->tile_cols - 1);
+    int row = std::min(std::max(static_cast<int>(record.y / tile_size), 0),
+      frame->tile_rows - 1);
+    uint32_t tile = static_cast<uint32_t>(row * frame->tile_cols + col);
+    tile_of[i] = tile;
+    tiles[tile].count++;
+    sums[3 * tile] += record.r;
+    sums[3 * tile + 1] += record.g;
+    sums[3 * tile + 2] += record.b;
+    frame->max_radius = std::max(frame->max_radius, record.radius);
+  }
+  uint32_t begin = 0;
+  for (size_t t = 0; t < tiles.size(); t++) {
+    draw_tile &tile = tiles[t];
+    tile.begin = begin;
+    begin += tile.count;
+    if (tile.count > 0) {
+      tile.r = static_cast<uint8_t>(sums[3 * t] / tile.count);
+      tile.g = static_cast<uint8_t>(sums[3 * t + 1] / tile.count);
+      tile.b = static_cast<uint8_t>(sums[3 * t + 2] / tile.count);
+    }
+  }
+  frame->tile_order.resize(records.size());
+  std::vector<uint32_t> next(tiles.size());
+  for (size_t t = 0; t < tiles.size(); t++) {
+    next[t] = tiles[t].begin;
+  }
+  for (size_t i = 0; i < records.size(); i++) {
+    frame->tile_order[next[tile_of[i]]++] = static_cast<uint32_t>(i);
+  }
+} /* BuildDrawTiles() */
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,177 @@
+/**
+ * @file draw_snapshot.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_DRAW_SNAPSHOT_H_
+#define SRC_DRAW_SNAPSHOT_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/common.h"
+#include "src/entity_type.h"
+#include "src/params.h"
+#include "src/tick_profiler.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Struct Definitions
+ ******************************************************************************/
+/**
+ * @brief What the viewer needs to draw one entity, packed in 24 bytes.
+ */
+struct draw_record {
+  float x{0};
+  float y{0};
+  float theta{0};  // degrees
+  float radius{0};
+  uint8_t r{0};
+  uint8_t g{0};
+  uint8_t b{0};
+  uint8_t type{kUndefined};  // an EntityType
+  uint32_t label{0};  // see draw_frame::get_label()
+};
+
+/**
+ * @brief A square tile of the arena, and the records centered in it.
+ */
+struct draw_tile {
+  // the records of the tile are those of draw_frame::tile_order from begin
+  uint32_t begin{0};
+  uint32_t count{0};
+  // the mean colour of the records
+  uint8_t r{0};
+  uint8_t g{0};
+  uint8_t b{0};
+};
+
+/**
+ * @brief Everything the viewer draws of an Arena at the end of a timestep.
+ * Once published, a frame is not changed until the viewer is done with it.
+ */
+struct draw_frame {
+  // one per entity, in Arena order
+  std::vector<draw_record> records{};
+  // the text of each label of the records, shared by the frames of an Arena
+  std::shared_ptr<const std::vector<std::string>> labels{};
+  int game_status{PLAYING};
+  // the last timestep, when the Arena is profiling
+  tick_stats stats{};
+
+  // The records by tile of tile_size units, row-major, so that those in a
+  // part of the arena are found without going through all of them. Empty
+  // unless built by BuildDrawTiles().
+  double tile_size{0};
+  int tile_cols{0};
+  int tile_rows{0};
+  std::vector<draw_tile> tiles{};
+  // the indices of the records, tile after tile
+  std::vector<uint32_t> tile_order{};
+  // the largest radius of the records, by which they overlap their tile
+  float max_radius{0};
+
+  const char *get_label(uint32_t label) const {
+    return (labels && label < labels->size()) ? (*labels)[label].c_str() : "";
+  }
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Sort the records of frame into tiles of tile_size units covering
+ * [0, x_dim] x [0, y_dim], by their centers. The records outside go to the
+ * nearest tile.
+ */
+void BuildDrawTiles(double x_dim, double y_dim, double tile_size,
+                    draw_frame *frame);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief The frames of an Arena, handed from the thread running it to the
+ * thread drawing it without locking: a triple buffer.
+ *
+ * The writer fills the back frame and Publish() swaps it with the middle
+ * one. The reader calls Acquire() to swap the front frame with the middle
+ * one, if it was published since, and then reads the front frame for as long
+ * as it likes. Neither ever waits for the other, and the reader always gets
+ * the last frame published. There must be one writer and one reader thread.
+ */
+class DrawSnapshot {
+ public:
+  DrawSnapshot() : frames_() {}
+
+  DrawSnapshot(const DrawSnapshot &other) = delete;
+  DrawSnapshot &operator=(const DrawSnapshot &other) = delete;
+
+  /**
+   * @brief The frame to fill next. Writer only.
+   */
+  draw_frame *get_back() { return &frames_[back_]; }
+
+  /**
+   * @brief Hand the back frame to the reader. Writer only.
+   */
+  void Publish() {
+    uint8_t middle = middle_.exchange(static_cast<uint8_t>(back_ | kFresh),
+      std::memory_order_acq_rel);
+    back_ = middle & kIndex;
+    sequence_.fetch_add(1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Make the last frame published the front one. Reader only.
+   *
+   * @return false if no frame was published since the last call, in which
+   * case the front frame is unchanged.
+   */
+  bool Acquire() {
+    if (!(middle_.load(std::memory_order_relaxed) & kFresh)) {
+      return false;
+    }
+    uint8_t middle = middle_.exchange(front_, std::memory_order_acq_rel);
+    front_ = middle & kIndex;
+    return true;
+  }
+
+  /**
+   * @brief The frame last acquired. Reader only.
+   */
+  const draw_frame &get_front() const { return frames_[front_]; }
+
+  /**
+   * @brief The number of frames published.
+   */
+  uint64_t get_sequence() const {
+    return sequence_.load(std::memory_order_acquire);
+  }
+
+ private:
+  static const uint8_t kIndex = 3;
+  static const uint8_t kFresh = 4;
+
+  draw_frame frames_[3];
+  uint8_t back_{0};
+  // the index of the middle frame, with kFresh set until it is acquired
+  std::atomic<uint8_t> middle_{1};
+  uint8_t front_{2};
+  std::atomic<uint64_t> sequence_{0};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_DRAW_SNAPSHOT_H_
@@ -8,7 +8,6 @@
  * Includes
  ******************************************************************************/
 #include <string>
-#include <ctime>
 #include <iostream>
 
 #include "src/common.h"
@@ -27,9 +26,7 @@ NAMESPACE_BEGIN(csci3081);
  * Class Definitions
  ******************************************************************************/
 
-EntityFactory::EntityFactory() {
-  srand(time(nullptr));
-}
+EntityFactory::EntityFactory(const Rng *rng) : rng_(rng) {}
 
 ArenaEntity* EntityFactory::CreateEntity(EntityType etype) {
   switch (etype) {
@@ -49,47 +46,87 @@ ArenaEntity* EntityFactory::CreateEntity(EntityType etype) {
   return nullptr;
 }
 
+void EntityFactory::DestroyEntity(ArenaEntity *entity) {
+  switch (entity->get_type()) {
+    case (kRobot): {
+      Robot* robot = dynamic_cast<Robot *>(entity);
+      robot_pool_.Destroy(robot_pool_.HandleOf(robot));
+      break;
+    }
+    case (kLight): {
+      Light* light = dynamic_cast<Light *>(entity);
+      light_pool_.Destroy(light_pool_.HandleOf(light));
+      break;
+    }
+    case (kFood): {
+      Food* food = dynamic_cast<Food *>(entity);
+      food_pool_.Destroy(food_pool_.HandleOf(food));
+      break;
+    }
+    default:
+      std::cout << "FATAL: Bad entity type on destruction\n";
+      assert(false);
+  }
+}
+
+void EntityFactory::Reset() {
+  entity_count_ = 0;
+  robot_count_ = 0;
+  light_count_ = 0;
+  food_count_ = 0;
+}
+
+void EntityFactory::Shrink() {
+  robot_pool_.Shrink();
+  light_pool_.Shrink();
+  food_pool_.Shrink();
+}
+
 Robot* EntityFactory::CreateRobot() {
-  auto* robot = new Robot;
+  Robot* robot = robot_pool_.Get(robot_pool_.Create());
   robot->set_type(kRobot);
   robot->set_color(ROBOT_COLOR);
-  robot->set_pose(SetPoseRandomly());
-  robot->set_radius(random_num(8, 14));
-  robot->set_heading(random_num(0, 360));
   ++entity_count_;
   ++robot_count_;
   robot->set_id(robot_count_);
+  RandomStream random = rng_->Stream(kRobot, robot_count_, 0);
+  robot->set_pose(SetPoseRandomly(&random));
+  robot->set_radius(random.Uniform(8, 14));
+  robot->set_heading(random.Uniform(0, 360));
   return robot;
 }
 
 Light* EntityFactory::CreateLight() {
-  auto* light = new Light;
+  Light* light = light_pool_.Get(light_pool_.Create());
   light->set_type(kLight);
   light->set_color(LIGHT_COLOR);
-  light->set_pose(SetPoseRandomly());
-  light->set_heading(random_num(0, 360));
   ++entity_count_;
   ++light_count_;
   light->set_id(light_count_);
+  RandomStream random = rng_->Stream(kLight, light_count_, 0);
+  light->set_pose(SetPoseRandomly(&random));
+  light->set_heading(random.Uniform(0, 360));
+  light->set_radius(random.Uniform(LIGHT_MIN_RADIUS, LIGHT_MAX_RADIUS));
   return light;
 }
 
 Food* EntityFactory::CreateFood() {
-  auto* food = new Food;
+  Food* food = food_pool_.Get(food_pool_.Create());
   food->set_type(kFood);
   food->set_color(FOOD_COLOR);
-  food->set_pose(SetPoseRandomly());
-  food->set_radius(FOOD_RADIUS);
   ++entity_count_;
   ++food_count_;
   food->set_id(food_count_);
+  RandomStream random = rng_->Stream(kFood, food_count_, 0);
+  food->set_pose(SetPoseRandomly(&random));
+  food->set_radius(FOOD_RADIUS);
   return food;
 }
 
-Pose EntityFactory::SetPoseRandomly() {
+Pose EntityFactory::SetPoseRandomly(RandomStream *random) {
   // Dividing arena into 19x14 grid. Each grid square is 50x50
-  return {static_cast<double>((30 + (random() % 19) * 50)),
-        static_cast<double>((30 + (random() % 14) * 50))};
+  return {static_cast<double>((30 + (random->Index(19)) * 50)),
+        static_cast<double>((30 + (random->Index(14)) * 50))};
 }
 
 NAMESPACE_END(csci3081);
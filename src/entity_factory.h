@@ -14,11 +14,13 @@
 
 #include "src/food.h"
 #include "src/common.h"
+#include "src/entity_pool.h"
 #include "src/entity_type.h"
 #include "src/light.h"
 #include "src/params.h"
 #include "src/pose.h"
 #include "src/rgb_color.h"
+#include "src/rng.h"
 #include "src/robot.h"
 
 /*******************************************************************************
@@ -35,21 +37,29 @@ NAMESPACE_BEGIN(csci3081);
  * The factory keeps track of the number of entities of each type and overall.
  * It assigns ID's to the entity when it creates it.
  * The factory randomly places entities, and in doing so, attempts to not
- * have them overlap.
+ * have them overlap. The random numbers of an entity are drawn from its own
+ * stream of the Arena's generator, so the placement only depends on the seed.
+ *
+ * The factory owns the entities it creates: each type is allocated from its
+ * own EntityPool, and the entities are destroyed with the factory.
  */
 class EntityFactory {
  public:
   /**
    * @brief EntityFactory constructor.
    *
+   * @param rng The generator of the Arena the entities are created for.
    */
-  EntityFactory();
+  explicit EntityFactory(const Rng *rng);
 
   /**
-   * @brief Default destructor.
+   * @brief Destroys every entity the factory created.
    */
   virtual ~EntityFactory() = default;
 
+  EntityFactory(const EntityFactory& other) = delete;
+  EntityFactory& operator=(const EntityFactory& other) = delete;
+
   /**
   * @brief CreateEntity is primary purpose of this class.
   *
@@ -63,6 +73,25 @@ class EntityFactory {
   */
   ArenaEntity* CreateEntity(EntityType etype);
 
+  /**
+   * @brief Return an entity created by this factory to its pool.
+   */
+  void DestroyEntity(ArenaEntity *entity);
+
+  /**
+   * @brief Number the entities created from now on as those of a new
+   * factory, so that they are placed as they would be in a new Arena.
+   *
+   * The entities already created must have been destroyed. Their slots are
+   * kept by the pools and reused.
+   */
+  void Reset();
+
+  /**
+   * @brief Release the pool slabs that the live entities no longer reach.
+   */
+  void Shrink();
+
  private:
    /**
    * @brief CreateRobot called from within CreateEntity.
@@ -85,7 +114,7 @@ class EntityFactory {
   /**
   * @brief An attempt to not overlap any of the newly constructed entities.
   */
-  Pose SetPoseRandomly();
+  Pose SetPoseRandomly(RandomStream *random);
 
   /* Factory tracks the number of created entities. There is no accounting for
    * the destruction of entities */
@@ -93,6 +122,11 @@ class EntityFactory {
   int robot_count_{0};
   int light_count_{0};
   int food_count_{0};
+  const Rng *rng_;
+
+  EntityPool<Robot> robot_pool_{};
+  EntityPool<Light> light_pool_{};
+  EntityPool<Food> food_pool_{};
 };
 
 NAMESPACE_END(csci3081);
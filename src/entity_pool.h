@@ -0,0 +1,205 @@
+/**
+ * @file entity_pool.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_ENTITY_POOL_H_
+#define SRC_ENTITY_POOL_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A growable pool of entities of one type, allocated in slabs.
+ *
+ * Entities are constructed in place in fixed-size slabs, so creating one is
+ * a pop from a free list, and a slab is only allocated when every slot is in
+ * use. Slabs never move: an entity keeps its address for as long as it lives.
+ * Destroying an entity pushes its slot back on the free list, and Shrink()
+ * releases the slabs at the end of the pool that hold no entity.
+ *
+ * A Handle names a slot and the generation of the entity in it. The
+ * generation changes each time the slot is freed, so a handle to a destroyed
+ * entity is detected instead of silently naming whatever took its slot.
+ *
+ * @tparam T The type of the entities.
+ */
+template <class T>
+class EntityPool {
+ public:
+  struct Handle {
+    uint32_t index{kNoSlot};
+    uint32_t generation{0};
+  };
+
+  explicit EntityPool(uint32_t slab_size = 256) : slab_size_(slab_size) {
+    assert(slab_size_ > 0);
+  }
+
+  ~EntityPool() {
+    for (uint32_t i = 0; i < n_slots_; i++) {
+      Slot *slot = SlotAt(i);
+      if (slot->live) {
+        slot->object()->~T();
+      }
+    }
+  }
+
+  EntityPool(const EntityPool &other) = delete;
+  EntityPool &operator=(const EntityPool &other) = delete;
+
+  /**
+   * @brief Construct an entity from args in a free slot.
+   */
+  template <typename... Args>
+  Handle Create(Args&&... args) {
+    if (free_ == kNoSlot) {
+      Grow();
+    }
+    Slot *slot = SlotAt(free_);
+    new (slot->storage) T(std::forward<Args>(args)...);
+    free_ = slot->next_free;
+    slot->live = true;
+    n_live_++;
+    return {slot->index, slot->generation};
+  }
+
+  /**
+   * @brief Destroy the entity of handle, which must be live.
+   */
+  void Destroy(Handle handle) {
+    Slot *slot = SlotAt(handle.index);
+    assert(slot->live && slot->generation == handle.generation);
+    slot->object()->~T();
+    slot->live = false;
+    slot->generation++;
+    slot->next_free = free_;
+    free_ = slot->index;
+    n_live_--;
+  }
+
+  /**
+   * @brief Free the trailing slabs that have no live entity, and put the
+   * remaining free slots back on the free list in index order.
+   *
+   * A slab grown again later starts its slots past every generation freed
+   * here, so the handles of the freed entities stay stale.
+   */
+  void Shrink() {
+    while (!slabs_.empty()) {
+      Slot *slab = slabs_.back().get();
+      bool empty = true;
+      uint32_t generation = generation_base_;
+      for (uint32_t i = 0; i < slab_size_; i++) {
+        empty = empty && !slab[i].live;
+        generation = std::max(generation, slab[i].generation);
+      }
+      if (!empty) {
+        break;
+      }
+      generation_base_ = generation;
+      slabs_.pop_back();
+      n_slots_ -= slab_size_;
+    }
+    free_ = kNoSlot;
+    for (uint32_t i = n_slots_; i > 0; i--) {
+      Slot *slot = SlotAt(i - 1);
+      if (!slot->live) {
+        slot->next_free = free_;
+        free_ = i - 1;
+      }
+    }
+  }
+
+  /**
+   * @brief The entity of handle, or nullptr if it was destroyed.
+   */
+  T *Get(Handle handle) const {
+    if (handle.index >= n_slots_) {
+      return nullptr;
+    }
+    Slot *slot = SlotAt(handle.index);
+    if (!slot->live || slot->generation != handle.generation) {
+      return nullptr;
+    }
+    return slot->object();
+  }
+
+  /**
+   * @brief The handle of an entity of this pool.
+   */
+  Handle HandleOf(const T *object) const {
+    // storage is the first member of a Slot
+    const Slot *slot = reinterpret_cast<const Slot *>(object);
+    return {slot->index, slot->generation};
+  }
+
+  /**
+   * @brief The number of live entities.
+   */
+  size_t size() const { return n_live_; }
+
+  size_t capacity() const { return n_slots_; }
+
+ private:
+  static const uint32_t kNoSlot = UINT32_MAX;
+
+  struct Slot {
+    alignas(T) unsigned char storage[sizeof(T)];
+    uint32_t index;
+    uint32_t generation;
+    uint32_t next_free;
+    bool live;
+
+    T *object() { return reinterpret_cast<T *>(storage); }
+  };
+
+  Slot *SlotAt(uint32_t index) const {
+    return &slabs_[index / slab_size_][index % slab_size_];
+  }
+
+  // Add a slab, and put its slots on the free list in index order.
+  void Grow() {
+    slabs_.emplace_back(new Slot[slab_size_]);
+    Slot *slab = slabs_.back().get();
+    for (uint32_t i = 0; i < slab_size_; i++) {
+      slab[i].index = n_slots_ + i;
+      slab[i].generation = generation_base_;
+      slab[i].next_free = (i + 1 < slab_size_) ? n_slots_ + i + 1 : free_;
+      slab[i].live = false;
+    }
+    free_ = n_slots_;
+    n_slots_ += slab_size_;
+  }
+
+  uint32_t slab_size_;
+  std::vector<std::unique_ptr<Slot[]>> slabs_{};
+  uint32_t n_slots_{0};
+  uint32_t n_live_{0};
+  // first slot of the free list
+  uint32_t free_{kNoSlot};
+  // generation of the slots of a new slab
+  uint32_t generation_base_{0};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_ENTITY_POOL_H_
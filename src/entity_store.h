@@ -0,0 +1,130 @@
+/**
+ * @file entity_store.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_ENTITY_STORE_H_
+#define SRC_ENTITY_STORE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <vector>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Struct Definitions
+ ******************************************************************************/
+/**
+ * @brief Structure-of-arrays entity state that the Arena reads and writes at
+ * every timestep.
+ *
+ * Entity i of the store is entity i of the Arena. Robots come first, then
+ * lights, then food, so each type occupies a contiguous index range and the
+ * per-tick passes can loop over plain arrays instead of chasing pointers and
+ * checking types.
+ *
+ * The store owns the pose, radius and wheel velocities of the entities of an
+ * Arena, and the light sensitivity of its robots: the Robot, Light and Food
+ * objects read and write their row through their accessors (see
+ * ArenaEntity::BindStore()), so nothing is copied in or out per timestep.
+ */
+struct EntityStore {
+ public:
+  /**
+   * @brief Set the number of entities of each type. Existing storage is
+   * reused, so resizing to the same counts does not allocate.
+   */
+  void Resize(size_t robots, size_t lights, size_t food) {
+    n_robots = robots;
+    n_lights = lights;
+    n_food = food;
+    size_t n = robots + lights + food;
+    x.resize(n);
+    y.resize(n);
+    theta.resize(n);
+    radius.resize(n);
+    vel_left.resize(robots + lights);
+    vel_right.resize(robots + lights);
+    resolved_x.resize(robots + lights);
+    resolved_y.resize(robots + lights);
+    left_x.resize(robots);
+    left_y.resize(robots);
+    right_x.resize(robots);
+    right_y.resize(robots);
+    light_sensitivity.resize(robots);
+    light_left.resize(robots);
+    light_right.resize(robots);
+    food_left.resize(robots);
+    food_right.resize(robots);
+    feeding.resize(robots);
+    food_cached.resize(robots);
+    cached_food_left.resize(robots);
+    cached_food_right.resize(robots);
+    cached_left_x.resize(robots);
+    cached_left_y.resize(robots);
+    cached_right_x.resize(robots);
+    cached_right_y.resize(robots);
+  }
+
+  size_t size() const { return n_robots + n_lights + n_food; }
+  size_t robot_begin() const { return 0; }
+  size_t robot_end() const { return n_robots; }
+  size_t light_begin() const { return n_robots; }
+  size_t light_end() const { return n_robots + n_lights; }
+  size_t food_begin() const { return n_robots + n_lights; }
+  size_t food_end() const { return size(); }
+  // Robots and lights are the mobile entities: [0, mobile_end())
+  size_t mobile_end() const { return n_robots + n_lights; }
+
+  size_t n_robots{0};
+  size_t n_lights{0};
+  size_t n_food{0};
+
+  // Pose and size, all entities
+  std::vector<double> x{};
+  std::vector<double> y{};
+  std::vector<double> theta{};
+  std::vector<double> radius{};
+
+  // Wheel velocities, mobile entities only
+  std::vector<double> vel_left{};
+  std::vector<double> vel_right{};
+  // Position after the entity-entity collisions, mobile entities only
+  std::vector<double> resolved_x{};
+  std::vector<double> resolved_y{};
+
+  // Sensors, robots only
+  std::vector<double> left_x{};
+  std::vector<double> left_y{};
+  std::vector<double> right_x{};
+  std::vector<double> right_y{};
+  std::vector<double> light_sensitivity{};
+  std::vector<double> light_left{};
+  std::vector<double> light_right{};
+  std::vector<double> food_left{};
+  std::vector<double> food_right{};
+  // Whether the robot is close enough to food to eat during this timestep
+  std::vector<char> feeding{};
+
+  // Food readings as last computed, and where the sensors were then, robots
+  // only. Kept across timesteps, see Arena::set_food_sensing_threshold().
+  std::vector<char> food_cached{};
+  std::vector<double> cached_food_left{};
+  std::vector<double> cached_food_right{};
+  std::vector<double> cached_left_x{};
+  std::vector<double> cached_left_y{};
+  std::vector<double> cached_right_x{};
+  std::vector<double> cached_right_y{};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_ENTITY_STORE_H_
@@ -28,15 +28,29 @@ Food::Food() : ArenaImmobileEntity(), captured_(false) {
 /*******************************************************************************
  * Member Functions
  ******************************************************************************/
-void Food::Reset() {
-  Pose new_position = {static_cast<double>((30+(random()%19)*50)),
-       static_cast<double>((30+(random()%14)*50))};
+void Food::Reset(RandomStream *random) {
+  Pose new_position = {static_cast<double>((30+(random->Index(19))*50)),
+       static_cast<double>((30+(random->Index(14))*50))};
   set_pose(new_position);
   set_color(FOOD_COLOR);
   set_radius(FOOD_RADIUS);
   set_captured(false);
 } /* Reset */
 
+void Food::SaveState(std::ostream &out) const {
+  ArenaImmobileEntity::SaveState(out);
+  WriteValue(out, static_cast<uint8_t>(captured_));
+} /* SaveState() */
+
+bool Food::LoadState(std::istream &in) {
+  uint8_t captured = 0;
+  if (!ArenaImmobileEntity::LoadState(in) || !ReadValue(in, &captured)) {
+    return false;
+  }
+  captured_ = (captured != 0);
+  return true;
+} /* LoadState() */
+
 void Food::ColorChange() {
   set_color(FOOD_COLOR_CHANGE);
 }
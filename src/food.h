@@ -46,7 +46,17 @@ class Food : public ArenaImmobileEntity {
    * @brief Reset the Food using the initialization parameters received
    * by the constructor.
    */
-  void Reset() override;
+  void Reset(RandomStream *random) override;
+
+  /**
+   * @brief Write whether the Food is captured to a checkpoint.
+   */
+  void SaveState(std::ostream &out) const override;
+
+  /**
+   * @brief Read back the state written by SaveState().
+   */
+  bool LoadState(std::istream &in) override;
 
   /**
    * @brief Change the color of food when it is captured
@@ -27,22 +27,16 @@ NAMESPACE_BEGIN(csci3081);
  */
 void FoodSensor::CalculateSensorReading(Pose food_pose, double food_radius,
   Pose sensor_pose) {
-  double delta_x = sensor_pose.x - food_pose.x;
-  double delta_y = sensor_pose.y - food_pose.y;
-  double distance_between = sqrt(delta_x*delta_x + delta_y*delta_y)
-  - food_radius;
-  if (distance_between < 0) {
-    distance_between = 0;
+  double distance_between = DistanceToSource(sensor_pose.x, sensor_pose.y,
+    food_pose.x, food_pose.y, food_radius);
+  //  Too far away to make a noticeable difference
+  if (distance_between > get_cutoff_distance()) {
+    return;
   }
 
-  double reading_to_set = get_reading() + 1200/(pow(1.01, distance_between));
-
   //  Keep the reading no greater than the maximum reading
-  if (reading_to_set > MAX_READING) {
-    set_reading(MAX_READING);
-  } else {
-    set_reading(reading_to_set);
-  }
+  set_reading(AddContribution(get_reading(), FOOD_SENSITIVITY,
+    distance_between));
 }
 
 NAMESPACE_END(csci3081);
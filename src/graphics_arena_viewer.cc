@@ -7,8 +7,12 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <vector>
 #include <iostream>
+#include <memory>
 #include <string>
 
 #include "src/graphics_arena_viewer.h"
@@ -24,14 +28,16 @@ NAMESPACE_BEGIN(csci3081);
  * Constructors/Destructor
  ******************************************************************************/
 GraphicsArenaViewer::GraphicsArenaViewer(
-    const struct arena_params *const params,
-    Arena * arena, Controller * controller) :
+    const struct arena_params *const params, Controller * controller) :
     GraphicsApp(
         params->x_dim + GUI_MENU_WIDTH + GUI_MENU_GAP * 2,
         params->y_dim,
         "Robot Simulation"),
     controller_(controller),
-    arena_(arena) {
+    x_dim_(params->x_dim),
+    y_dim_(params->y_dim) {
+  replay_frame_.labels = std::make_shared<const std::vector<std::string>>(
+    std::vector<std::string>{"C", "E"});
   auto *gui = new nanogui::FormHelper(screen());
   nanogui::ref<nanogui::Window> window =
       gui->addWindow(
@@ -56,6 +62,43 @@ GraphicsArenaViewer::GraphicsArenaViewer(
       "Turn off Food",
       std::bind(&GraphicsArenaViewer::OnFoodOnBtnPressed, this));
   food_on_button_->setFixedWidth(100);
+  fast_forward_button_ =
+    gui->addButton(
+      "Fast Forward",
+      std::bind(&GraphicsArenaViewer::OnFastForwardBtnPressed, this));
+  fast_forward_button_->setFixedWidth(100);
+  profile_button_ =
+    gui->addButton(
+      "Show Profile",
+      std::bind(&GraphicsArenaViewer::OnProfileBtnPressed, this));
+  profile_button_->setFixedWidth(100);
+
+  // *************** SPEED SLIDER ************************//
+  // The slider is logarithmic: from 1/4 to SIMULATION_MAX_MULTIPLIER times
+  // real time, with 1 at a quarter of the way.
+  nanogui::Widget *speed_panel = new nanogui::Widget(window);
+  new nanogui::Label(speed_panel, "Simulation Speed", "sans-bold");
+  nanogui::Slider *speed_slider = new nanogui::Slider(speed_panel);
+  speed_slider->setValue(0.25f);
+  speed_slider->setFixedWidth(100);
+  nanogui::TextBox *speed_box = new nanogui::TextBox(speed_panel);
+  speed_box->setFixedSize(nanogui::Vector2i(60, 25));
+  speed_box->setFontSize(20);
+  speed_box->setValue("1.00");
+  speed_box->setUnits("x");
+  auto speed_of = [](float value) {
+    return 0.25 * std::pow(4.0 * SIMULATION_MAX_MULTIPLIER, value);
+  };
+  speed_slider->setCallback(
+    [speed_box, speed_of, this](float value) {
+      char text[16];
+      snprintf(text, sizeof(text), "%.2f", speed_of(value));
+      speed_box->setValue(text);
+      controller_->set_speed(speed_of(value));
+    });
+  speed_panel->setLayout(new nanogui::BoxLayout(
+    nanogui::Orientation::Vertical, nanogui::Alignment::Middle, 0, 15));
+
   gui->addGroup("Arena Configuration");
 
   // Creating a panel impacts the layout. Widgets, sliders, buttons can be
@@ -213,9 +256,26 @@ void GraphicsArenaViewer::OnPauseBtnPressed() {
 void GraphicsArenaViewer::OnStartNewGameBtnPressed() {
   paused_ = true;
   pause_button_->setCaption("Play");
-  arena_->Reset();
   controller_->AcceptCommunication(kNewGame);
-  arena_ = controller_->getArena();
+}
+
+void GraphicsArenaViewer::OnFastForwardBtnPressed() {
+  controller_->set_fast_forward(!controller_->get_clock()->is_fast_forward());
+  if (controller_->get_clock()->is_fast_forward()) {
+    fast_forward_button_->setCaption("Real Time");
+  } else {
+    fast_forward_button_->setCaption("Fast Forward");
+  }
+}
+
+void GraphicsArenaViewer::OnProfileBtnPressed() {
+  show_profile_ = !show_profile_;
+  controller_->AcceptCommunication(show_profile_ ? kProfileOn : kProfileOff);
+  if (show_profile_) {
+    profile_button_->setCaption("Hide Profile");
+  } else {
+    profile_button_->setCaption("Show Profile");
+  }
 }
 
 void GraphicsArenaViewer::OnFoodOnBtnPressed() {
@@ -254,26 +314,63 @@ void GraphicsArenaViewer::OnSpecialKeyDown(int key,
   controller_->AcceptCommunication(key_value);
 }
 
+void GraphicsArenaViewer::OnKeyDown(const char *c, __unused int modifiers) {
+  if (!c) {
+    return;
+  }
+  switch (c[0]) {
+    case '+':
+    case '=':
+      ZoomView(GUI_ZOOM_STEP);
+      break;
+    case '-':
+      ZoomView(1 / GUI_ZOOM_STEP);
+      break;
+    case '0':
+      zoom_ = 1;
+      view_x_ = 0;
+      view_y_ = 0;
+      break;
+    default: {}
+  }
+}
+
+void GraphicsArenaViewer::OnLeftMouseDrag(const Point2& pos,
+                                          const Vector2& delta) {
+  // not when dragging over the menu
+  if (pos.x() > x_dim_) {
+    return;
+  }
+  view_x_ -= delta.x() / zoom_;
+  view_y_ -= delta.y() / zoom_;
+}
+
+void GraphicsArenaViewer::ZoomView(double factor) {
+  double center_x = view_x_ + x_dim_ / (2 * zoom_);
+  double center_y = view_y_ + y_dim_ / (2 * zoom_);
+  zoom_ = std::min(std::max(zoom_ * factor, GUI_MIN_ZOOM),
+                   static_cast<double>(GUI_MAX_ZOOM));
+  view_x_ = center_x - x_dim_ / (2 * zoom_);
+  view_y_ = center_y - y_dim_ / (2 * zoom_);
+}
+
 /*******************************************************************************
  * Drawing of Entities in Arena
  ******************************************************************************/
 void GraphicsArenaViewer::DrawRobot(NVGcontext *ctx,
-                                     const Robot *const robot) {
+                                    const draw_record &record,
+                                    const char *name) {
   // translate and rotate all graphics calls that follow so that they are
   // centered, at the position and heading of this robot
   nvgSave(ctx);
-  nvgTranslate(ctx,
-               static_cast<float>(robot->get_pose().x),
-               static_cast<float>(robot->get_pose().y));
+  nvgTranslate(ctx, record.x, record.y);
   nvgRotate(ctx,
-            static_cast<float>(robot->get_pose().theta * M_PI / 180.0));
+            static_cast<float>(record.theta * M_PI / 180.0));
 
   // robot's circle
   nvgBeginPath(ctx);
-  nvgCircle(ctx, 0.0, 0.0, static_cast<float>(robot->get_radius()));
-  nvgFillColor(ctx,
-               nvgRGBA(robot->get_color().r, robot->get_color().g,
-                       robot->get_color().b, 255));
+  nvgCircle(ctx, 0.0, 0.0, record.radius);
+  nvgFillColor(ctx, nvgRGBA(record.r, record.g, record.b, 255));
   nvgFill(ctx);
   nvgStrokeColor(ctx, nvgRGBA(0, 0, 0, 255));
   nvgStroke(ctx);
@@ -281,12 +378,12 @@ void GraphicsArenaViewer::DrawRobot(NVGcontext *ctx,
   nvgSave(ctx);
   nvgRotate(ctx, static_cast<float>(M_PI / 2.0));
   nvgFillColor(ctx, nvgRGBA(0, 0, 0, 255));
-  nvgText(ctx, 0.0, 0.0, robot->get_name().c_str(), nullptr);
+  nvgText(ctx, 0.0, 0.0, name, nullptr);
 
   nvgRotate(ctx, (-40 * M_PI / 180.0)+ M_PI);
-  nvgText(ctx, 0.0, robot->get_radius(), "I", nullptr);
+  nvgText(ctx, 0.0, record.radius, "I", nullptr);
   nvgRotate(ctx, (+80 * M_PI/180.0));
-  nvgText(ctx, 0.0, robot->get_radius(), "I", nullptr);
+  nvgText(ctx, 0.0, record.radius, "I", nullptr);
 
   nvgRestore(ctx);
   nvgRestore(ctx);
@@ -295,32 +392,177 @@ void GraphicsArenaViewer::DrawRobot(NVGcontext *ctx,
 void GraphicsArenaViewer::DrawArena(NVGcontext *ctx) {
   nvgBeginPath(ctx);
   // Creates new rectangle shaped sub-path.
-  nvgRect(ctx, 0, 0, arena_->get_x_dim(), arena_->get_y_dim());
+  nvgRect(ctx, 0, 0, x_dim_, y_dim_);
   nvgStrokeColor(ctx, nvgRGBA(255, 255, 255, 255));
   nvgStroke(ctx);
 }
 
 void GraphicsArenaViewer::DrawEntity(NVGcontext *ctx,
-                                       const ArenaEntity *const entity) {
+                                     const draw_record &record,
+                                     const char *name) {
   // light's circle
   nvgBeginPath(ctx);
-  nvgCircle(ctx,
-            static_cast<float>(entity->get_pose().x),
-            static_cast<float>(entity->get_pose().y),
-            static_cast<float>(entity->get_radius()));
-  nvgFillColor(ctx,
-               nvgRGBA(entity->get_color().r, entity->get_color().g,
-                       entity->get_color().b, 255));
+  nvgCircle(ctx, record.x, record.y, record.radius);
+  nvgFillColor(ctx, nvgRGBA(record.r, record.g, record.b, 255));
   nvgFill(ctx);
   nvgStrokeColor(ctx, nvgRGBA(0, 0, 0, 255));
   nvgStroke(ctx);
 
   // light id text label
   nvgFillColor(ctx, nvgRGBA(0, 0, 0, 255));
-  nvgText(ctx,
-          static_cast<float>(entity->get_pose().x),
-          static_cast<float>(entity->get_pose().y),
-          entity->get_name().c_str(), nullptr);
+  nvgText(ctx, record.x, record.y, name, nullptr);
+}
+
+void GraphicsArenaViewer::DrawBatched(NVGcontext *ctx,
+                                      const std::vector<draw_record> &records,
+                                      const std::vector<uint32_t> &indices) {
+  batch_order_.resize(indices.size());
+  for (size_t k = 0; k < indices.size(); k++) {
+    uint32_t i = indices[k];
+    const draw_record &record = records[i];
+    uint64_t colour = (uint64_t{record.r} << 16) | (uint64_t{record.g} << 8) |
+      record.b;
+    batch_order_[k] = (uint64_t{record.type} << 56) | (colour << 32) | i;
+  }
+  std::sort(batch_order_.begin(), batch_order_.end());
+
+  // one path, filled and stroked once, per run of the same type and colour
+  nvgStrokeColor(ctx, nvgRGBA(0, 0, 0, 255));
+  size_t begin = 0;
+  while (begin < batch_order_.size()) {
+    uint64_t run = batch_order_[begin] >> 32;
+    const draw_record &first = records[batch_order_[begin] & 0xffffffff];
+    size_t end = begin;
+    nvgBeginPath(ctx);
+    for (; end < batch_order_.size() && run == batch_order_[end] >> 32;
+         end++) {
+      const draw_record &record = records[batch_order_[end] & 0xffffffff];
+      nvgCircle(ctx, record.x, record.y, record.radius);
+    }
+    nvgFillColor(ctx, nvgRGBA(first.r, first.g, first.b, 255));
+    nvgFill(ctx);
+    nvgStroke(ctx);
+    begin = end;
+  } /* while(begin..) */
+
+  // a radial tick at each sensor of each robot, as one path
+  const float half_tick = GUI_SENSOR_TICK / 2.0f;
+  const float to_radians = static_cast<float>(M_PI / 180.0);
+  nvgBeginPath(ctx);
+  for (uint32_t i : indices) {
+    const draw_record &record = records[i];
+    if (kRobot != record.type) {
+      continue;
+    }
+    for (float angle : {float{LEFT_SENSOR}, float{RIGHT_SENSOR}}) {
+      float theta = (record.theta + angle) * to_radians;
+      float dx = std::cos(theta);
+      float dy = std::sin(theta);
+      nvgMoveTo(ctx, record.x + (record.radius - half_tick) * dx,
+                record.y + (record.radius - half_tick) * dy);
+      nvgLineTo(ctx, record.x + (record.radius + half_tick) * dx,
+                record.y + (record.radius + half_tick) * dy);
+    }
+  } /* for(i..) */
+  nvgStroke(ctx);
+}
+
+void GraphicsArenaViewer::DrawLabels(NVGcontext *ctx,
+                                     const draw_frame &frame,
+                                     const std::vector<uint32_t> &indices) {
+  nvgFillColor(ctx, nvgRGBA(0, 0, 0, 255));
+  for (uint32_t i : indices) {
+    const draw_record &record = frame.records[i];
+    nvgText(ctx, record.x, record.y, frame.get_label(record.label), nullptr);
+  }
+}
+
+void GraphicsArenaViewer::DrawDensityTiles(NVGcontext *ctx,
+                                           const draw_frame &frame) {
+  const float size = static_cast<float>(frame.tile_size);
+  for (uint32_t t : dense_tiles_) {
+    const draw_tile &tile = frame.tiles[t];
+    float x = size * static_cast<float>(t % frame.tile_cols);
+    float y = size * static_cast<float>(t / frame.tile_cols);
+    float density = std::min(1.0f,
+      static_cast<float>(tile.count) / GUI_DENSITY_FULL_ENTITIES);
+    nvgBeginPath(ctx);
+    nvgRect(ctx, x, y, std::min(size, static_cast<float>(x_dim_) - x),
+            std::min(size, static_cast<float>(y_dim_) - y));
+    nvgFillColor(ctx, nvgRGBA(tile.r, tile.g, tile.b,
+      static_cast<unsigned char>(64 + 191 * density)));
+    nvgFill(ctx);
+  }
+}
+
+void GraphicsArenaViewer::CollectVisible(const draw_frame &frame) {
+  visible_.clear();
+  dense_tiles_.clear();
+  if (frame.tiles.empty()) {
+    for (size_t i = 0; i < frame.records.size(); i++) {
+      visible_.push_back(static_cast<uint32_t>(i));
+    }
+    return;
+  }
+
+  // The tiles in view, widened by the largest radius, as a record may
+  // overlap the view from the tile next to it
+  double margin = frame.max_radius;
+  auto tile_of = [&frame](double u, int n) {
+    return std::min(std::max(static_cast<int>(std::floor(u / frame.tile_size)),
+                             0), n - 1);
+  };
+  int col_begin = tile_of(view_x_ - margin, frame.tile_cols);
+  int col_end = tile_of(view_x_ + x_dim_ / zoom_ + margin, frame.tile_cols);
+  int row_begin = tile_of(view_y_ - margin, frame.tile_rows);
+  int row_end = tile_of(view_y_ + y_dim_ / zoom_ + margin, frame.tile_rows);
+  bool aggregate = zoom_ < GUI_DETAIL_MIN_ZOOM;
+  for (int row = row_begin; row <= row_end; row++) {
+    for (int col = col_begin; col <= col_end; col++) {
+      uint32_t t = static_cast<uint32_t>(row * frame.tile_cols + col);
+      const draw_tile &tile = frame.tiles[t];
+      if (aggregate && tile.count >= GUI_DENSITY_MIN_ENTITIES) {
+        dense_tiles_.push_back(t);
+        continue;
+      }
+      visible_.insert(visible_.end(),
+        frame.tile_order.begin() + tile.begin,
+        frame.tile_order.begin() + tile.begin + tile.count);
+    }
+  } /* for(row..) */
+}
+
+void GraphicsArenaViewer::ApplyView(NVGcontext *ctx) {
+  nvgScissor(ctx, 0, 0, static_cast<float>(x_dim_),
+             static_cast<float>(y_dim_));
+  nvgScale(ctx, static_cast<float>(zoom_), static_cast<float>(zoom_));
+  nvgTranslate(ctx, static_cast<float>(-view_x_),
+               static_cast<float>(-view_y_));
+}
+
+void GraphicsArenaViewer::DrawRecords(NVGcontext *ctx,
+                                      const draw_frame &frame) {
+  CollectVisible(frame);
+  DrawDensityTiles(ctx, frame);
+  bool labels = zoom_ >= GUI_DETAIL_MIN_ZOOM;
+  if (visible_.size() > GUI_BATCH_MIN_ENTITIES) {
+    DrawBatched(ctx, frame.records, visible_);
+    if (labels && visible_.size() <= GUI_LABEL_MAX_ENTITIES) {
+      DrawLabels(ctx, frame, visible_);
+    }
+    return;
+  }
+  // in Arena order, as the tiles mix it up
+  std::sort(visible_.begin(), visible_.end());
+  for (uint32_t i : visible_) {
+    const draw_record &record = frame.records[i];
+    const char *name = labels ? frame.get_label(record.label) : "";
+    if (kRobot == record.type) {
+      DrawRobot(ctx, record, name);
+    } else {
+      DrawEntity(ctx, record, name);
+    }
+  } /* for(i..) */
 }
 
 void GraphicsArenaViewer::DrawIndication(NVGcontext *ctx) {
@@ -337,22 +579,106 @@ void GraphicsArenaViewer::DrawIndication(NVGcontext *ctx) {
   nvgText(ctx, 400, 400, "A Robot is dead!", nullptr);
 }
 
+void GraphicsArenaViewer::DrawProfile(NVGcontext *ctx,
+                                      const tick_stats &stats) {
+  const float line = 16.0f;
+  float y = 20.0f;
+  nvgSave(ctx);
+  nvgFontSize(ctx, 14.0f);
+  nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
+  nvgFillColor(ctx, nvgRGBA(255, 255, 255, 255));
+  if (!TickProfiler::is_available()) {
+    nvgText(ctx, 10, y, "profiling not compiled in (make PROFILING=1)",
+            nullptr);
+    nvgRestore(ctx);
+    return;
+  }
+
+  char text[64];
+  snprintf(text, sizeof(text), "tick %.1f us", 1e6 * stats.seconds);
+  nvgText(ctx, 10, y, text, nullptr);
+  for (int p = 0; p < kPhaseCount; p++) {
+    y += line;
+    snprintf(text, sizeof(text), "%-16s %8.1f us",
+             TickProfiler::PhaseName(static_cast<TickPhase>(p)),
+             1e6 * stats.phase_seconds[p]);
+    nvgText(ctx, 10, y, text, nullptr);
+  }
+  for (int c = 0; c < kCounterCount; c++) {
+    y += line;
+    snprintf(text, sizeof(text), "%-16s %8llu",
+             TickProfiler::CounterName(static_cast<TickCounter>(c)),
+             static_cast<unsigned long long>(stats.counts[c]));  // NOLINT
+    nvgText(ctx, 10, y, text, nullptr);
+  }
+  nvgRestore(ctx);
+}
+
+void GraphicsArenaViewer::DrawReplay(NVGcontext *ctx) {
+  TrajectoryReader *replay = controller_->get_replay();
+  uint64_t tick = controller_->get_replay_tick();
+  if (!replay->ReadTick(tick, &replay_samples_)) {
+    return;
+  }
+  const RgbColor color = ROBOT_COLOR;
+  std::vector<draw_record> &records = replay_frame_.records;
+  records.resize(replay_samples_.size());
+  for (size_t i = 0; i < replay_samples_.size(); i++) {
+    const trajectory_sample &sample = replay_samples_[i];
+    draw_record &record = records[i];
+    record.x = sample.x;
+    record.y = sample.y;
+    record.theta = sample.theta;
+    record.radius = static_cast<float>(replay->get_radius(i));
+    record.r = static_cast<uint8_t>(color.r);
+    record.g = static_cast<uint8_t>(color.g);
+    record.b = static_cast<uint8_t>(color.b);
+    record.type = kRobot;
+    record.label = (kExplorer == replay->get_robot_type(i)) ? 1 : 0;
+  }
+  BuildDrawTiles(x_dim_, y_dim_, DRAW_TILE_SIZE, &replay_frame_);
+  nvgSave(ctx);
+  ApplyView(ctx);
+  DrawRecords(ctx, replay_frame_);
+  nvgRestore(ctx);
+
+  char text[64];
+  snprintf(text, sizeof(text), "replay: tick %llu of %llu",
+           static_cast<unsigned long long>(tick + 1),  // NOLINT
+           static_cast<unsigned long long>(replay->get_n_ticks()));  // NOLINT
+  nvgFillColor(ctx, nvgRGBA(255, 255, 255, 255));
+  nvgText(ctx, static_cast<float>(x_dim_ / 2), 20, text,
+          nullptr);
+}
+
 void GraphicsArenaViewer::DrawUsingNanoVG(NVGcontext *ctx) {
   // initialize text rendering settings
   nvgFontSize(ctx, 18.0f);
   nvgFontFace(ctx, "sans-bold");
   nvgTextAlign(ctx, NVG_ALIGN_CENTER | NVG_ALIGN_MIDDLE);
+  nvgSave(ctx);
+  ApplyView(ctx);
   DrawArena(ctx);
-  std::vector<ArenaEntity *> entities = arena_->get_entities();
-  for (auto &entity : entities) {
-    if (kRobot == entity->get_type()) {
-      DrawRobot(ctx, dynamic_cast<Robot*>(entity));
-    } else {
-      DrawEntity(ctx, entity);
-    }
-  } /* for(i..) */
-  if (arena_->get_game_status()== LOST) {
+  nvgRestore(ctx);
+  // a recording only holds the robots, and does not run the arena
+  if (controller_->is_replaying()) {
+    DrawReplay(ctx);
+    return;
+  }
+  // the last frame published by the simulation thread, if any since the
+  // previous one
+  DrawSnapshot *snapshot = controller_->get_draw_snapshot();
+  snapshot->Acquire();
+  const draw_frame &frame = snapshot->get_front();
+  nvgSave(ctx);
+  ApplyView(ctx);
+  DrawRecords(ctx, frame);
+  nvgRestore(ctx);
+  if (frame.game_status == LOST) {
   DrawIndication(ctx);}
+  if (show_profile_) {
+    DrawProfile(ctx, frame.stats);
+  }
 }
 
 NAMESPACE_END(csci3081);
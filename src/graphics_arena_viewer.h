@@ -16,6 +16,7 @@
 #include "src/controller.h"
 #include "src/common.h"
 #include "src/communication.h"
+#include "src/trajectory_reader.h"
 
 /*******************************************************************************
  * Namespaces
@@ -60,16 +61,10 @@ class GraphicsArenaViewer : public GraphicsApp {
    *
    * @param params A arena_params passed down from main.cc for the
    * initialization of the Arena and the entities therein.
+   * @param controller The Controller running the Arena drawn.
    */
-  explicit GraphicsArenaViewer(const struct arena_params *const params,
-                               Arena *arena, Controller *controller);
-
-  /**
-   * @brief Destructor.
-   *
-   * `delete` the contained Arena.
-   */
-  ~GraphicsArenaViewer() override { delete arena_; }
+  GraphicsArenaViewer(const struct arena_params *const params,
+                      Controller *controller);
 
   /**
    * @brief Informs the Arena of the new time, so that it can update.
@@ -100,6 +95,20 @@ class GraphicsArenaViewer : public GraphicsApp {
    */
   void OnFoodOnBtnPressed();
 
+  /**
+   * @brief Handle the user pressing the fast forward button on the GUI.
+   *
+   * This switches between running as many timesteps as each frame allows
+   * and running at the speed of the speed slider.
+   */
+  void OnFastForwardBtnPressed();
+
+  /**
+   * @brief Handle the user pressing the show profile button on the GUI.
+   *
+   * This switches the Arena's tick profiler, and its overlay, on and off.
+   */
+  void OnProfileBtnPressed();
 
   /**
    * @brief Called each time the mouse moves on the screen within the GUI
@@ -122,6 +131,15 @@ class GraphicsArenaViewer : public GraphicsApp {
    */
   void OnLeftMouseDown(__unused const Point2& pos) override {};
 
+  /**
+   * @brief Called each time the mouse moves with the left button held: pans
+   * the view of the Arena along.
+   *
+   * @param[in] pos The position of the mouse, in pixels.
+   * @param[in] delta How far the mouse has moved, in pixels.
+   */
+  void OnLeftMouseDrag(const Point2& pos, const Vector2& delta) override;
+
   /**
    * @brief Called each time the left mouse button is released.
    *
@@ -152,10 +170,13 @@ class GraphicsArenaViewer : public GraphicsApp {
   /**
    * @brief Called each time a character key is pressed.
    *
+   * `+` and `-` zoom the view of the Arena in and out, about its center, and
+   * `0` shows the whole Arena again.
+   *
    * @param[in] c Character representing a key that was pressed.
    * @param[in] modifiers Any modifier keys that were also pressed.
    */
-  void OnKeyDown(__unused const char *c, __unused int modifiers) override {};
+  void OnKeyDown(const char *c, __unused int modifiers) override;
 
   /**
    * @brief Called each time a character key is released.
@@ -214,10 +235,6 @@ class GraphicsArenaViewer : public GraphicsApp {
    */
   GraphicsArenaViewer(const GraphicsArenaViewer &other) = delete;
 
-  // void ChangeToNewArena(Arena *arena){
-    // *arena_ =arena;
-  // }
-
   int get_robot_count() {
     return robot_count_;
   }
@@ -251,9 +268,17 @@ class GraphicsArenaViewer : public GraphicsApp {
    * should probably only be called from with DrawUsingNanoVG.
    *
    * @param[in] ctx The `nanovg` context.
-   * @param[in] robot The Robot handle.
+   * @param[in] record The draw record of the Robot.
+   * @param[in] name The text label of the Robot.
    */
-  void DrawRobot(NVGcontext *ctx, const class Robot *const robot);
+  void DrawRobot(NVGcontext *ctx, const draw_record &record,
+                 const char *name);
+
+  /**
+   * @brief Draw the robots at the tick of the recording played back by the
+   * Controller.
+   */
+  void DrawReplay(NVGcontext *ctx);
 
   /**
    * @brief Draw an Light in the Arena using `nanogui`.
@@ -262,9 +287,70 @@ class GraphicsArenaViewer : public GraphicsApp {
    * should probably only be called from with DrawUsingNanoVG.
    *
    * @param[in] ctx The `nanovg` context.
-   * @param[in] light The Light handle.
+   * @param[in] record The draw record of the Light or Food.
+   * @param[in] name The text label of the Light or Food.
+   */
+  void DrawEntity(NVGcontext *ctx, const draw_record &record,
+                  const char *name);
+
+  /**
+   * @brief Draw many entities with a few `nanovg` calls: the circles of each
+   * colour as one path, then the sensor ticks of every robot as one path.
+   *
+   * Draws no text; see DrawLabels().
+   *
+   * @param[in] ctx The `nanovg` context.
+   * @param[in] records The draw records of the entities.
+   * @param[in] indices The indices of the records to draw.
+   */
+  void DrawBatched(NVGcontext *ctx, const std::vector<draw_record> &records,
+                   const std::vector<uint32_t> &indices);
+
+  /**
+   * @brief Draw the text label of each entity at its center, unrotated.
+   *
+   * @param[in] ctx The `nanovg` context.
+   * @param[in] frame The draw records of the entities, and their labels.
+   * @param[in] indices The indices of the records to draw.
+   */
+  void DrawLabels(NVGcontext *ctx, const draw_frame &frame,
+                  const std::vector<uint32_t> &indices);
+
+  /**
+   * @brief Draw each tile of dense_tiles_ as a square of the mean colour of
+   * its entities, more opaque the more entities it holds.
    */
-  void DrawEntity(NVGcontext *ctx, const class ArenaEntity *const entity);
+  void DrawDensityTiles(NVGcontext *ctx, const draw_frame &frame);
+
+  /**
+   * @brief Find what is in view of frame: the tiles drawn as a whole in
+   * dense_tiles_, and the records drawn one by one in visible_. Only the
+   * tiles in view are looked at, if the frame has any.
+   */
+  void CollectVisible(const draw_frame &frame);
+
+  /**
+   * @brief Clip the drawing to the Arena's part of the window, and map the
+   * Arena coordinates that follow to the view.
+   */
+  void ApplyView(NVGcontext *ctx);
+
+  /**
+   * @brief Multiply the zoom by factor, within [GUI_MIN_ZOOM, GUI_MAX_ZOOM],
+   * keeping the center of the view in place.
+   */
+  void ZoomView(double factor);
+
+  /**
+   * @brief Draw the entities in view one by one, or, when there are more
+   * than GUI_BATCH_MIN_ENTITIES of them, in batches, without labels past
+   * GUI_LABEL_MAX_ENTITIES. Zoomed out below GUI_DETAIL_MIN_ZOOM, there are
+   * no labels, and dense tiles are drawn instead of their entities.
+   *
+   * @param[in] ctx The `nanovg` context.
+   * @param[in] frame The draw records of the entities, and their labels.
+   */
+  void DrawRecords(NVGcontext *ctx, const draw_frame &frame);
 
   /**
    * @brief Draw an WIN or LOSE indication in the Arena using `nanogui`.
@@ -276,10 +362,26 @@ class GraphicsArenaViewer : public GraphicsApp {
    */
   void DrawIndication(NVGcontext *ctx);
 
+  /**
+   * @brief Draw the time spent in each phase of the last timesteps, and the
+   * counters of the tick profiler, over the top left of the Arena.
+   *
+   * @param[in] ctx The `nanovg` context.
+   * @param[in] stats The profile of the last timestep.
+   */
+  void DrawProfile(NVGcontext *ctx, const tick_stats &stats);
+
   Controller *controller_;
-  Arena *arena_;
+  double x_dim_;
+  double y_dim_;
+
+  // the view of the Arena: pixels per unit, and the point at the top left
+  double zoom_{1};
+  double view_x_{0};
+  double view_y_{0};
   bool paused_{true};
   bool has_food_{true};
+  bool show_profile_{false};
   int robot_count_ {10};
   int light_count_{4};
   int ratio_{50};
@@ -291,6 +393,19 @@ class GraphicsArenaViewer : public GraphicsApp {
   nanogui::Button *pause_button_{nullptr};
   nanogui::Button *start_new_game_button_{nullptr};
   nanogui::Button *food_on_button_{nullptr};
+  nanogui::Button *fast_forward_button_{nullptr};
+  nanogui::Button *profile_button_{nullptr};
+
+  // robots of the recording at the tick drawn
+  std::vector<trajectory_sample> replay_samples_{};
+  draw_frame replay_frame_{};
+
+  // the records drawn in batches, ordered by type then colour, as
+  // type << 56 | colour << 32 | index
+  std::vector<uint64_t> batch_order_{};
+  // what CollectVisible() found in view
+  std::vector<uint32_t> visible_{};
+  std::vector<uint32_t> dense_tiles_{};
 };
 
 NAMESPACE_END(csci3081);
@@ -0,0 +1,237 @@
+/**
+ * @file headless_main.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "src/arena_params.h"
+#include "src/batch_runner.h"
+#include "src/tick_profiler.h"
+#include "src/trajectory_recorder.h"
+#include "src/wiring.h"
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+static void PrintUsage(const char *program) {
+  std::cerr << "Usage: " << program << " [options]\n"
+    << "Runs one simulation without graphics and prints its statistics as "
+    << "CSV.\n"
+    << "  --ticks N        timesteps to simulate (default 10000)\n"
+    << "  --robots N       number of robots\n"
+    << "  --lights N       number of lights\n"
+    << "  --food N         number of food\n"
+    << "  --ratio N        percentage of fearful robots\n"
+    << "  --sensitivity N  light sensitivity of the robots\n"
+    << "  --food-on 0|1    whether robots need food\n"
+    << "  --threads N      threads running each timestep\n"
+    << "  --seed N         seed of the placement of the entities (default 0,\n"
+    << "                   a random seed, which is printed)\n"
+    << "  --sensing all|cutoff|field\n"
+    << "  --food-radius D  distance beyond which food is not sensed, for\n"
+    << "                   --sensing cutoff|field (default 0, for none)\n"
+    << "  --field-cell N   distance between the nodes of the stimulus\n"
+    << "                   fields, for --sensing field\n"
+    << "  --food-threshold D  distance a robot's food sensors move before\n"
+    << "                   their readings are computed again (default 0)\n"
+    << "  --response exact|table|polynomial\n"
+    << "  --controller policy|wiring\n"
+    << "  --wiring FILE    wiring matrices of the robot behaviours, for\n"
+    << "                   --controller wiring (which it implies)\n"
+    << "  --profile N      log the time of each timestep phase every N\n"
+    << "                   timesteps (needs make PROFILING=1)\n"
+    << "  --record FILE    record the robots at every timestep to FILE\n"
+    << "  --checkpoint FILE  save the state of the arena to FILE at the end\n"
+    << "  --resume FILE    continue from a checkpoint, whose arena replaces\n"
+    << "                   the one given by the options\n";
+}
+
+static bool ParseDistance(const char *text, double *value) {
+  char *end = nullptr;
+  double parsed = std::strtod(text, &end);
+  if (*text == '\0' || *end != '\0' || !(parsed >= 0)) {
+    return false;
+  }
+  *value = parsed;
+  return true;
+}
+
+static bool ParseCount(const char *text, size_t *value) {
+  char *end = nullptr;
+  int64_t parsed = std::strtoll(text, &end, 10);
+  if (*text == '\0' || *end != '\0' || parsed < 0) {
+    return false;
+  }
+  *value = static_cast<size_t>(parsed);
+  return true;
+}
+
+int main(int argc, char **argv) {
+  csci3081::arena_params params;
+  size_t ticks = 10000;
+  size_t profile_interval = 0;
+  std::string record_file;
+  std::string checkpoint_file;
+  std::string resume_file;
+
+  for (int i = 1; i < argc; i++) {
+    std::string option = argv[i];
+    if (option == "--help") {
+      PrintUsage(argv[0]);
+      return 0;
+    }
+    if (i + 1 >= argc) {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+    const char *value = argv[++i];
+    size_t count = 0;
+    bool ok = true;
+    if (option == "--record") {
+      record_file = value;
+    } else if (option == "--checkpoint") {
+      checkpoint_file = value;
+    } else if (option == "--resume") {
+      resume_file = value;
+    } else if (option == "--wiring") {
+      std::ifstream wiring_file(value);
+      std::string line;
+      if (!wiring_file ||
+          !csci3081::ReadWirings(wiring_file, &params.wirings, &line)) {
+        std::cerr << "Cannot read the wiring " << value << ": " << line
+          << "\n";
+        return 1;
+      }
+      params.controller_mode = csci3081::kControllerWiring;
+    } else if (option == "--controller") {
+      if (std::strcmp(value, "policy") == 0) {
+        params.controller_mode = csci3081::kControllerPolicy;
+      } else if (std::strcmp(value, "wiring") == 0) {
+        params.controller_mode = csci3081::kControllerWiring;
+      } else {
+        ok = false;
+      }
+    } else if (option == "--sensing") {
+      if (std::strcmp(value, "all") == 0) {
+        params.sensing_mode = csci3081::kSenseAll;
+      } else if (std::strcmp(value, "cutoff") == 0) {
+        params.sensing_mode = csci3081::kSenseCutoff;
+      } else if (std::strcmp(value, "field") == 0) {
+        params.sensing_mode = csci3081::kSenseField;
+      } else {
+        ok = false;
+      }
+    } else if (option == "--food-radius") {
+      ok = ParseDistance(value, &params.food_sensing_radius);
+    } else if (option == "--food-threshold") {
+      ok = ParseDistance(value, &params.food_sensing_threshold);
+    } else if (option == "--response") {
+      if (std::strcmp(value, "exact") == 0) {
+        params.response_mode = csci3081::kResponseExact;
+      } else if (std::strcmp(value, "table") == 0) {
+        params.response_mode = csci3081::kResponseTable;
+      } else if (std::strcmp(value, "polynomial") == 0) {
+        params.response_mode = csci3081::kResponsePolynomial;
+      } else {
+        ok = false;
+      }
+    } else if (!ParseCount(value, &count)) {
+      ok = false;
+    } else if (option == "--ticks") {
+      ticks = count;
+    } else if (option == "--robots") {
+      params.n_robots = count;
+    } else if (option == "--lights") {
+      params.n_lights = count;
+    } else if (option == "--food") {
+      params.n_food = count;
+    } else if (option == "--ratio") {
+      params.n_ratio = count;
+    } else if (option == "--sensitivity") {
+      params.n_light_sensitivity = count;
+    } else if (option == "--food-on") {
+      params.food_on = (count != 0);
+    } else if (option == "--threads") {
+      params.n_threads = count;
+    } else if (option == "--seed") {
+      params.seed = static_cast<uint32_t>(count);
+    } else if (option == "--field-cell" && count > 0) {
+      params.field_cell_size = static_cast<double>(count);
+    } else if (option == "--profile") {
+      profile_interval = count;
+    } else {
+      ok = false;
+    }
+    if (!ok) {
+      std::cerr << "Invalid option " << option << " " << value << "\n";
+      PrintUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  std::ifstream resume;
+  if (!resume_file.empty()) {
+    resume.open(resume_file, std::ios::binary);
+    if (!csci3081::Arena::ReadCheckpointParams(resume, &params)) {
+      std::cerr << "Cannot read the checkpoint " << resume_file << "\n";
+      return 1;
+    }
+  }
+
+  std::string error = csci3081::BatchRunner::CheckParams(params);
+  if (!error.empty()) {
+    std::cerr << "Invalid parameters: " << error << "\n";
+    return 1;
+  }
+
+  csci3081::BatchRunner runner(params);
+  if (!resume_file.empty()) {
+    resume.seekg(0);
+    if (!runner.get_arena()->RestoreCheckpoint(resume)) {
+      std::cerr << "Cannot read the checkpoint " << resume_file << "\n";
+      return 1;
+    }
+  }
+  if (profile_interval > 0) {
+    if (!csci3081::TickProfiler::is_available()) {
+      std::cerr << "Profiling is not compiled in, build with PROFILING=1\n";
+    }
+    runner.get_arena()->set_profiling(true);
+    runner.get_arena()->get_profiler()->set_log(&std::cerr, profile_interval);
+  }
+  csci3081::TrajectoryRecorder recorder;
+  if (!record_file.empty()) {
+    if (!recorder.Open(record_file)) {
+      std::cerr << "Cannot write " << record_file << "\n";
+      return 1;
+    }
+    runner.get_arena()->set_recorder(&recorder);
+  }
+  csci3081::run_summary summary = runner.Run(static_cast<int>(ticks));
+  if (!record_file.empty() && !recorder.Close()) {
+    std::cerr << "Cannot write " << record_file << "\n";
+    return 1;
+  }
+  if (!checkpoint_file.empty()) {
+    std::ofstream checkpoint(checkpoint_file, std::ios::binary);
+    if (!checkpoint || !runner.get_arena()->SaveCheckpoint(checkpoint)) {
+      std::cerr << "Cannot write " << checkpoint_file << "\n";
+      return 1;
+    }
+  }
+  csci3081::BatchRunner::WriteCsvHeader(std::cout);
+  // The parameters of the arena hold the seed it drew, when none was given
+  csci3081::BatchRunner::WriteCsvRow(std::cout,
+    runner.get_arena()->get_params(), summary);
+  return 0;
+}
@@ -25,8 +25,7 @@ Light::Light() :
      direc_angle_{180} {
   set_color(LIGHT_COLOR);
   set_pose(LIGHT_POSITION);
-  set_radius(LIGHT_RADIUS);
-  set_heading(random_num(0, 360));
+  set_radius(LIGHT_MIN_RADIUS);
   set_type(kLight);
   motion_handler_.set_velocity(LIGHT_SPEED, LIGHT_SPEED);
 }
@@ -41,6 +40,13 @@ Light::Light() :
   * done, and reset the is_reverse_arc to false.
   */
 void Light::TimestepUpdate(unsigned int dt) {
+  UpdateVelocity();
+
+  // Use velocity and position to update position
+  motion_behavior_.UpdatePose(dt, motion_handler_.get_velocity());
+} /* TimestepUpdate() */
+
+void Light::UpdateVelocity() {
   // When doing a reverse arc
   if (is_reverse_arc) {
     ReverseArc();
@@ -48,22 +54,41 @@ void Light::TimestepUpdate(unsigned int dt) {
       // no reverse arc is needed, moving in a regular manner
       motion_handler_.set_velocity(LIGHT_SPEED, LIGHT_SPEED);
     }
+} /* UpdateVelocity() */
 
-  // Use velocity and position to update position
-  motion_behavior_.UpdatePose(dt, motion_handler_.get_velocity());
-
-  // Reset Sensor for next cycle
-} /* TimestepUpdate() */
-
-void Light::Reset() {
-  Pose light_pose = {static_cast<double>((30+(random()%19)*50)),
-       static_cast<double>((30+(random()%14)*50))};
+void Light::Reset(RandomStream *random) {
+  Pose light_pose = {static_cast<double>((30+(random->Index(19))*50)),
+       static_cast<double>((30+(random->Index(14))*50))};
   set_pose(light_pose);
-  set_heading(random_num(0, 360));
-  set_radius(random_num(LIGHT_MIN_RADIUS, LIGHT_MAX_RADIUS));
+  set_heading(random->Uniform(0, 360));
+  set_radius(random->Uniform(LIGHT_MIN_RADIUS, LIGHT_MAX_RADIUS));
   motion_handler_.set_velocity(LIGHT_SPEED, LIGHT_SPEED);;
 } /* Reset() */
 
+void Light::SaveState(std::ostream &out) const {
+  ArenaMobileEntity::SaveState(out);
+  WheelVelocity velocity = motion_handler_.get_velocity();
+  WriteValue(out, velocity.left);
+  WriteValue(out, velocity.right);
+  WriteValue(out, static_cast<uint8_t>(is_reverse_arc));
+  WriteValue(out, static_cast<int32_t>(direc_angle_));
+} /* SaveState() */
+
+bool Light::LoadState(std::istream &in) {
+  double left = 0, right = 0;
+  uint8_t reverse_arc = 0;
+  int32_t direc_angle = 0;
+  if (!ArenaMobileEntity::LoadState(in) || !ReadValue(in, &left) ||
+      !ReadValue(in, &right) || !ReadValue(in, &reverse_arc) ||
+      !ReadValue(in, &direc_angle)) {
+    return false;
+  }
+  motion_handler_.set_velocity(left, right);
+  is_reverse_arc = (reverse_arc != 0);
+  direc_angle_ = direc_angle;
+  return true;
+} /* LoadState() */
+
 void Light::HandleCollision() {
   is_reverse_arc = true;  // Starts to move in a reverse arc
   }
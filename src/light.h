@@ -66,11 +66,28 @@ class Light : public ArenaMobileEntity {
    */
   void TimestepUpdate(unsigned int dt) override;
 
+  /**
+   * @brief The first half of TimestepUpdate(): set the wheel velocities (and
+   * turn, when doing a reverse arc) without moving.
+   */
+  void UpdateVelocity();
+
   /**
    * @brief Reset the light to a newly constructed state (needed for reset
    * button to work in GUI).
    */
-  void Reset() override;
+  void Reset(RandomStream *random) override;
+
+  /**
+   * @brief Write the wheel velocities and reverse arc of the Light to a
+   * checkpoint.
+   */
+  void SaveState(std::ostream &out) const override;
+
+  /**
+   * @brief Read back the state written by SaveState().
+   */
+  bool LoadState(std::istream &in) override;
 
 
   /**
@@ -0,0 +1,120 @@
+/**
+ * @file light_sensing_kernel.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+
+#include "src/light_sensing_kernel.h"
+#include "src/params.h"
+#include "src/simd.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/* 2^x. x is split into round(x) + f with |f| <= 0.5, 2^round(x) is built
+ * directly from its exponent bits and 2^f = e^(f ln2) comes from its Taylor
+ * series, whose truncation error is below 1e-14 on [-0.5, 0.5].
+ */
+static inline Vec Exp2(Vec x) {
+  const Vec round = Set1(kRoundingShift);
+  x = Min(Max(x, Set1(-1022)), Set1(1023));
+  Vec rounded = Add(x, round);
+  Vec f = Sub(x, Sub(rounded, round));
+
+  Vec p = Set1(2.5678435993488196e-11);
+  p = Add(Mul(p, f), Set1(4.44553827187081e-10));
+  p = Add(Mul(p, f), Set1(7.054911620801121e-09));
+  p = Add(Mul(p, f), Set1(1.0178086009239696e-07));
+  p = Add(Mul(p, f), Set1(1.3215486790144305e-06));
+  p = Add(Mul(p, f), Set1(1.5252733804059838e-05));
+  p = Add(Mul(p, f), Set1(0.00015403530393381606));
+  p = Add(Mul(p, f), Set1(0.0013333558146428441));
+  p = Add(Mul(p, f), Set1(0.009618129107628477));
+  p = Add(Mul(p, f), Set1(0.055504108664821576));
+  p = Add(Mul(p, f), Set1(0.2402265069591007));
+  p = Add(Mul(p, f), Set1(0.6931471805599453));
+  p = Add(Mul(p, f), Set1(1.0));
+  // 2^round(x), built from the integer held by rounded
+  return Mul(p, ShiftLeftInt(AddInt(rounded, 1023), 52));
+}
+
+/* Accumulate every light into kLanes sensors. neg_log2 holds
+ * -log2(sensitivity) of each sensor.
+ */
+static void AccumulateBlock(const double *sensor_x, const double *sensor_y,
+  const double *neg_log2, size_t n_lights, const double *light_x,
+  const double *light_y, const double *light_radius, double cutoff,
+  double *readings) {
+  Vec sx = Load(sensor_x);
+  Vec sy = Load(sensor_y);
+  Vec exponent = Load(neg_log2);
+  Vec reading = Load(readings);
+  const Vec zero = Set1(0);
+  const Vec gain = Set1(SENSOR_GAIN);
+  const Vec max_reading = Set1(MAX_READING);
+  const Vec max_distance = Set1(cutoff);
+
+  for (size_t j = 0; j < n_lights; j++) {
+    Vec delta_x = Sub(sx, Set1(light_x[j]));
+    Vec delta_y = Sub(sy, Set1(light_y[j]));
+    Vec distance = Sqrt(Add(Mul(delta_x, delta_x), Mul(delta_y, delta_y)));
+    distance = Sub(distance, Set1(light_radius[j]));
+    distance = Max(distance, zero);
+    // SENSOR_GAIN / sensitivity^distance
+    Vec contribution = Mul(gain, Exp2(Mul(distance, exponent)));
+    // Too far away to make a noticeable difference
+    contribution = AndNot(Greater(distance, max_distance), contribution);
+    // Keep the reading no greater than the maximum reading
+    reading = Min(Add(reading, contribution), max_reading);
+  }
+  Store(readings, reading);
+}
+
+void AccumulateLightReadings(size_t n_sensors, const double *sensor_x,
+  const double *sensor_y, const double *sensitivity, size_t n_lights,
+  const double *light_x, const double *light_y, const double *light_radius,
+  double cutoff, double *readings) {
+  double neg_log2[kLanes];
+  size_t i = 0;
+  for (; i + kLanes <= n_sensors; i += kLanes) {
+    for (size_t k = 0; k < kLanes; k++) {
+      neg_log2[k] = -std::log2(sensitivity[i + k]);
+    }
+    AccumulateBlock(sensor_x + i, sensor_y + i, neg_log2, n_lights, light_x,
+      light_y, light_radius, cutoff, readings + i);
+  }
+  if (i == n_sensors) {
+    return;
+  }
+
+  // The last, padded block (see simd.h)
+  double x[kLanes] = {0};
+  double y[kLanes] = {0};
+  double reading[kLanes] = {0};
+  size_t n_left = n_sensors - i;
+  for (size_t k = 0; k < kLanes; k++) {
+    neg_log2[k] = 0;
+  }
+  for (size_t k = 0; k < n_left; k++) {
+    x[k] = sensor_x[i + k];
+    y[k] = sensor_y[i + k];
+    reading[k] = readings[i + k];
+    neg_log2[k] = -std::log2(sensitivity[i + k]);
+  }
+  AccumulateBlock(x, y, neg_log2, n_lights, light_x, light_y, light_radius,
+    cutoff, reading);
+  std::copy(reading, reading + n_left, readings + i);
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,65 @@
+/**
+ * @file light_sensing_kernel.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_LIGHT_SENSING_KERNEL_H_
+#define SRC_LIGHT_SENSING_KERNEL_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constant Definitions
+ ******************************************************************************/
+/**
+ * Largest relative difference between a reading computed by
+ * AccumulateLightReadings() and the same reading computed one light at a
+ * time by LightSensor::CalculateSensorReading().
+ */
+#define LIGHT_KERNEL_TOLERANCE 1e-12
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Add the contribution of every light to the readings of many light
+ * sensors at once.
+ *
+ * This is the batched version of LightSensor::CalculateSensorReading(): for
+ * each sensor, every light closer than cutoff adds
+ * SENSOR_GAIN / sensitivity^distance to the reading, which is kept no greater
+ * than MAX_READING. sensitivity^distance is computed as
+ * exp2(distance * log2(sensitivity)) with a polynomial exp2, several sensors
+ * at a time (see simd.h). The readings stay within LIGHT_KERNEL_TOLERANCE of
+ * the one light at a time computation.
+ *
+ * @param n_sensors The number of sensors.
+ * @param sensor_x The x position of each sensor.
+ * @param sensor_y The y position of each sensor.
+ * @param sensitivity The sensitivity of each sensor.
+ * @param n_lights The number of lights.
+ * @param light_x The x position of each light.
+ * @param light_y The y position of each light.
+ * @param light_radius The radius of each light.
+ * @param cutoff Lights further than this from a sensor are ignored.
+ * @param[in,out] readings The reading of each sensor, added to.
+ */
+void AccumulateLightReadings(size_t n_sensors, const double *sensor_x,
+  const double *sensor_y, const double *sensitivity, size_t n_lights,
+  const double *light_x, const double *light_y, const double *light_radius,
+  double cutoff, double *readings);
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_LIGHT_SENSING_KERNEL_H_
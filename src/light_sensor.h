@@ -59,6 +59,8 @@ class LightSensor : public Sensor {
      sensitivity_ = sense;
   }
 
+  double get_sensitivity() const { return sensitivity_; }
+
  private:
   // sensitivity is 1.08 as default
   double sensitivity_{1.08};
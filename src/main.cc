@@ -8,6 +8,7 @@
  * Includes
  ******************************************************************************/
 #include <iostream>
+#include <string>
 
 #include "src/arena_params.h"
 #include "src/controller.h"
@@ -16,11 +17,21 @@
 /*******************************************************************************
  * Non-Member Functions
  ******************************************************************************/
-int main(__unused int argc, __unused char **argv) {
+int main(int argc, char **argv) {
   // The controller creates both the arena and viewer
   auto *controller = new csci3081::Controller;
 
+  // `arenaviewer --replay FILE` plays back a recording of the headless runs
+  if (argc == 3 && std::string(argv[1]) == "--replay") {
+    if (!controller->OpenReplay(argv[2])) {
+      std::cerr << "Cannot read the recording " << argv[2] << std::endl;
+      return 1;
+    }
+  }
+
   // The controller will call Run of the viewer
   controller->Run();
+  // and stops the simulation thread once the window is closed
+  delete controller;
   return 0;
 }
@@ -30,8 +30,7 @@ NAMESPACE_BEGIN(csci3081);
 class MotionBehaviorDifferential : public MotionBehavior {
  public:
   explicit MotionBehaviorDifferential(ArenaMobileEntity * entity)
-      : MotionBehavior(entity) , radius_(entity_->get_radius()),
-        temp_vel_(0, 0) {
+      : MotionBehavior(entity) , radius_(entity_->get_radius()) {
   }
 
   MotionBehaviorDifferential(const MotionBehaviorDifferential& other) = default;
@@ -54,32 +53,21 @@ class MotionBehaviorDifferential : public MotionBehavior {
    */
   void UpdatePose(double dt, WheelVelocity vel) override;
 
- private:
-  /**
-   * @brief Get the radius of the ICC
-   */
-  double icc_radius() const;
-
-  /**
-   * @brief Get the angular velocity, in rad/sec.
-   */
-  double omega() const;
-
   /**
-   * @brief Get the Instantaneous Center of Curvature (ICC) of the entity.
+   * @brief The differential drive model behind UpdatePose(), applied to a
+   * pose that is not necessarily held by an entity.
    *
-   * @param pose The entities current pose.
+   * This is IntegrateDifferentialDrive() for a single pose; the Arena calls
+   * that directly on the poses of all its mobile entities.
    *
-   * @return The center of curvature (theta component of pose unused).
+   * @param[in] dt Elapsed time interval.
+   * @param[in] vel The wheel velocities.
+   * @param[in,out] pose The pose to advance.
    */
-  struct Pose calc_icc(struct Pose pose) const;
+  static void Integrate(double dt, WheelVelocity vel, Pose *pose);
 
+ private:
   double radius_;
-
-  // Velocity is stored in motion handler. Value is passed in here and used to
-  // calculate new pose. Its used in various functions, hence the temp var
-  // instead of passing it around from function to function.
-  WheelVelocity temp_vel_;
 };
 
 NAMESPACE_END(csci3081);
@@ -31,6 +31,8 @@ NAMESPACE_BEGIN(csci3081);
  * motion behavior, not the handler.
  * The pose.heading might change at each timestep (if wheel velocities are
  * not equivalent), again determined by the motion behavior.
+ * The wheel velocities are kept by the entity, so that they live in the
+ * entity store along with its pose.
  */
 class MotionHandler {
  public:
@@ -38,7 +40,7 @@ class MotionHandler {
    * @brief Constructor.
    */
   explicit MotionHandler(ArenaMobileEntity * ent)
-    : velocity_(0, 0), entity_(ent) {
+    : entity_(ent) {
     }
 
   virtual ~MotionHandler() {}
@@ -97,28 +99,29 @@ class MotionHandler {
   /**
    * @brief Getter for WheelVelocity struct, which has a .left and .right value.
    */
-  WheelVelocity get_velocity() const { return velocity_; }
+  WheelVelocity get_velocity() const { return entity_->get_velocity(); }
 
   /**
    * @brief Setter for WheelVelocity struct with struct as input param.
    */
-  void set_velocity(WheelVelocity vel) { velocity_ = vel; }
+  void set_velocity(WheelVelocity vel) {
+    entity_->set_velocity(vel.left, vel.right);
+  }
 
   /**
    * @brief Setter for WheelVelocity struct with input params of .left and
    * .right components.
    */
   void set_velocity(double vl, double vr) {
-    velocity_.left = vl;
-    velocity_.right = vr;
+    entity_->set_velocity(vl, vr);
   }
 
   double get_left_velocity() {
-    return velocity_.left;
+    return get_velocity().left;
   }
 
   double get_right_velocity() {
-    return velocity_.right;
+    return get_velocity().right;
   }
 
 
@@ -130,7 +133,6 @@ class MotionHandler {
   double max_angle_{360};
   double speed_delta_{1};
   double angle_delta_{1};
-  WheelVelocity velocity_;
 
  protected:
   ArenaMobileEntity * entity_;
@@ -55,59 +55,6 @@ class MotionHandlerExplore : public MotionHandler {
    double fd_left_reading, double fd_right_reading, int hungry_level,
    bool hunger_exist)
     override;
-
-  /**
-   * @brief Calculate the left wheel speed at exploration mode
-   * @param lt_right_reading right light sensor reading
-   * @return the right wheel speed at exploration mode
-   */
-  double LeftSpeedExplore(double lt_right_reading);
-
-  /**
-   * @brief Calculate the right wheel speed at exploration mode
-   * @param lt_left_reading left light sensor reading
-   * @return the right wheel speed at exploration mode
-   */
-  double RightSpeedExplore(double lt_left_reading);
-
-  /**
-   * @brief Calculate the left wheel speed at aggression mode
-   * @param fd_right_reading right food sensor reading
-   * @return the left wheel speed at aggression mode
-   */
-  double LeftSpeedAggressive(double fd_right_reading);
-
-  /**
-   * @brief Calculate the right wheel speed at aggression mode
-   * @param fd_left_reading left food sensor reading
-   * @return the right wheel speed at aggression mode
-   */
-  double RightSpeedAggressive(double fd_left_reading);
-
-  /**
-   * @brief Calculate the left wheel speed at hungry mode
-   * @param lt_right_reading right light sensor reading
-   * @param fd_right_reading right food sensor reading
-   * @return the left wheel speed at hungry mode
-   */
-  double LeftSpeedHungry(double lt_right_reading, double fd_right_reading);
-
-  /**
-   * @brief Calculate the right wheel speed at hungry mode
-   * @param lt_left_reading left light sensor reading
-   * @param fd_left_reading left food sensor reading
-   * @return the right wheel speed at hungry mode
-   */
-  double RightSpeedHungry(double lt_left_reading, double fd_left_reading);
-
-
- private:
-   /**
-    * @brief Keep the velocity not excceding the max velocity
-    * @param vel The max velocity.
-    * return The velocity that is already checked
-    */
-  double clamp_vel(double vel);
 };
 
 NAMESPACE_END(csci3081);
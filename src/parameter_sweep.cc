@@ -0,0 +1,171 @@
+/**
+ * @file parameter_sweep.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <thread>
+
+#include "src/parameter_sweep.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * SweepWriter
+ ******************************************************************************/
+SweepWriter::SweepWriter(std::ostream *out, Format format)
+    : out_(out), format_(format), mutex_() {
+  if (kCsv == format_) {
+    *out_ << "set,replicate,";
+    BatchRunner::WriteCsvHeader(*out_);
+    out_->flush();
+  }
+}
+
+void SweepWriter::Write(const sweep_result &result) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const arena_params &params = result.params;
+  const run_summary &summary = result.summary;
+  if (kCsv == format_) {
+    *out_ << result.set << ',' << result.replicate << ',';
+    BatchRunner::WriteCsvRow(*out_, params, summary);
+  } else {
+    *out_ << "{\"set\":" << result.set
+          << ",\"replicate\":" << result.replicate
+          << ",\"seed\":" << result.seed
+          << ",\"n_robots\":" << params.n_robots
+          << ",\"n_lights\":" << params.n_lights
+          << ",\"n_food\":" << params.n_food
+          << ",\"n_ratio\":" << params.n_ratio
+          << ",\"n_light_sensitivity\":" << params.n_light_sensitivity
+          << ",\"food_on\":" << (params.food_on ? "true" : "false")
+          << ",\"status\":\"" << (summary.status == LOST ? "lost" : "playing")
+          << "\",\"ticks\":" << summary.ticks
+          << ",\"n_hungry\":" << summary.n_hungry
+          << ",\"n_starving\":" << summary.n_starving
+          << ",\"mean_hunger\":" << summary.mean_hunger
+          << ",\"max_hunger\":" << summary.max_hunger
+          << ",\"seconds\":" << summary.seconds << "}\n";
+  }
+  out_->flush();
+}
+
+/*******************************************************************************
+ * ParameterSweep
+ ******************************************************************************/
+ParameterSweep::ParameterSweep() : sets_() {}
+
+void ParameterSweep::AddGrid(const sweep_grid &grid,
+  const arena_params &base) {
+  arena_params params = base;
+  for (size_t robots : grid.n_robots) {
+    params.n_robots = robots;
+    for (size_t lights : grid.n_lights) {
+      params.n_lights = lights;
+      for (size_t food : grid.n_food) {
+        params.n_food = food;
+        for (size_t ratio : grid.n_ratio) {
+          params.n_ratio = ratio;
+          for (size_t sensitivity : grid.n_light_sensitivity) {
+            params.n_light_sensitivity = sensitivity;
+            for (bool food_on : grid.food_on) {
+              params.food_on = food_on;
+              sets_.push_back(params);
+            }
+          }
+        }
+      }
+    }
+  }
+} /* AddGrid() */
+
+uint32_t ParameterSweep::RunSeed(size_t set, int replicate) const {
+  // splitmix64 of the run coordinates
+  uint64_t z = (static_cast<uint64_t>(base_seed_) << 32)
+    ^ (static_cast<uint64_t>(set) * replicates_ + replicate);
+  z += 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  z ^= z >> 31;
+  uint32_t seed = static_cast<uint32_t>(z);
+  return (seed == 0) ? 1 : seed;
+} /* RunSeed() */
+
+sweep_result ParameterSweep::RunOne(size_t run,
+  std::unique_ptr<BatchRunner> *runner) const {
+  sweep_result result;
+  result.set = run / replicates_;
+  result.replicate = static_cast<int>(run % replicates_);
+  result.seed = RunSeed(result.set, result.replicate);
+  result.params = sets_[result.set];
+  result.params.seed = result.seed;
+  // The runs are the parallelism: each Arena uses a single thread.
+  result.params.n_threads = 1;
+
+  if (*runner) {
+    (*runner)->Reconfigure(result.params);
+  } else {
+    runner->reset(new BatchRunner(result.params));
+  }
+  result.summary = (*runner)->Run(max_ticks_);
+  return result;
+} /* RunOne() */
+
+bool ParameterSweep::NextRun(size_t worker, std::vector<WorkQueue> *queues,
+  size_t *run) {
+  {
+    WorkQueue &own = (*queues)[worker];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.runs.empty()) {
+      *run = own.runs.front();
+      own.runs.pop_front();
+      return true;
+    }
+  }
+  // Steal the last run of another worker, the one it would run last.
+  for (size_t k = 1; k < queues->size(); k++) {
+    WorkQueue &victim = (*queues)[(worker + k) % queues->size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.runs.empty()) {
+      *run = victim.runs.back();
+      victim.runs.pop_back();
+      return true;
+    }
+  }
+  return false;
+} /* NextRun() */
+
+void ParameterSweep::Run(size_t n_workers, SweepWriter *writer) {
+  size_t n_runs = sets_.size() * static_cast<size_t>(replicates_);
+  if (n_workers == 0) {
+    n_workers = 1;
+  }
+  std::vector<WorkQueue> queues(n_workers);
+  for (size_t run = 0; run < n_runs; run++) {
+    queues[run % n_workers].runs.push_back(run);
+  }
+
+  auto work = [this, &queues, writer](size_t worker) {
+    size_t run = 0;
+    std::unique_ptr<BatchRunner> runner;
+    while (NextRun(worker, &queues, &run)) {
+      writer->Write(RunOne(run, &runner));
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t worker = 1; worker < n_workers; worker++) {
+    workers.emplace_back(work, worker);
+  }
+  work(0);
+  for (auto &thread : workers) {
+    thread.join();
+  }
+} /* Run() */
+
+NAMESPACE_END(csci3081);
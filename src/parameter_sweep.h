@@ -0,0 +1,147 @@
+/**
+ * @file parameter_sweep.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_PARAMETER_SWEEP_H_
+#define SRC_PARAMETER_SWEEP_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "src/arena_params.h"
+#include "src/batch_runner.h"
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief The values taken by each swept field of arena_params. A sweep over
+ * a grid runs every combination of these values.
+ */
+struct sweep_grid {
+  std::vector<size_t> n_robots{N_ROBOTS};
+  std::vector<size_t> n_lights{4};
+  std::vector<size_t> n_food{4};
+  std::vector<size_t> n_ratio{50};
+  std::vector<size_t> n_light_sensitivity{80};
+  std::vector<bool> food_on{true};
+};
+
+/**
+ * @brief One finished run of a sweep.
+ */
+struct sweep_result {
+  // index of the parameter set within the sweep
+  size_t set{0};
+  int replicate{0};
+  uint32_t seed{0};
+  arena_params params{};
+  run_summary summary{};
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Writes the results of a sweep as they come, as CSV (one header line,
+ * then one line per run) or as JSON Lines (one object per run).
+ *
+ * Write() can be called from any thread; each result is written and flushed
+ * as a whole.
+ */
+class SweepWriter {
+ public:
+  enum Format { kCsv, kJson };
+
+  SweepWriter(std::ostream *out, Format format);
+
+  SweepWriter(const SweepWriter& other) = delete;
+  SweepWriter& operator=(const SweepWriter& other) = delete;
+
+  void Write(const sweep_result &result);
+
+ private:
+  std::ostream *out_;
+  Format format_;
+  std::mutex mutex_;
+};
+
+/**
+ * @brief Runs many independent Arenas, over every parameter set and
+ * replicate, on all cores.
+ *
+ * Each run gets its own seed, derived from the base seed, the parameter set
+ * and the replicate, so the result of a run does not depend on the number of
+ * workers or on which worker runs it. Runs are dealt round-robin to the
+ * workers, and a worker that runs out of work steals from the back of the
+ * queue of another worker. Each worker reuses one Arena for all its runs.
+ */
+class ParameterSweep {
+ public:
+  ParameterSweep();
+
+  /**
+   * @brief Add one parameter set to the sweep.
+   */
+  void AddParams(const arena_params &params) { sets_.push_back(params); }
+
+  /**
+   * @brief Add every combination of the values of grid, the other fields
+   * being taken from base.
+   */
+  void AddGrid(const sweep_grid &grid, const arena_params &base);
+
+  const std::vector<arena_params> &get_sets() const { return sets_; }
+
+  void set_replicates(int replicates) { replicates_ = replicates; }
+  void set_max_ticks(int max_ticks) { max_ticks_ = max_ticks; }
+  void set_base_seed(uint32_t seed) { base_seed_ = seed; }
+
+  /**
+   * @brief The seed of a replicate of a parameter set. Never 0.
+   */
+  uint32_t RunSeed(size_t set, int replicate) const;
+
+  /**
+   * @brief Run every replicate of every parameter set on n_workers threads,
+   * and pass each result to writer as soon as its run finishes.
+   */
+  void Run(size_t n_workers, SweepWriter *writer);
+
+ private:
+  struct WorkQueue {
+    std::mutex mutex{};
+    std::deque<size_t> runs{};
+  };
+
+  bool NextRun(size_t worker, std::vector<WorkQueue> *queues, size_t *run);
+  /**
+   * @brief Run one run on runner, which is created by the first run of a
+   * worker and reconfigured for the next ones.
+   */
+  sweep_result RunOne(size_t run, std::unique_ptr<BatchRunner> *runner) const;
+
+  std::vector<arena_params> sets_;
+  int replicates_{1};
+  int max_ticks_{10000};
+  uint32_t base_seed_{1};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_PARAMETER_SWEEP_H_
@@ -26,8 +26,38 @@
 #define TEXT_BOX_WIDTH 50
 #define GUI_MENU_WIDTH 180
 #define GUI_MENU_GAP 10
+// above this many entities, they are drawn in batches of one colour
+#define GUI_BATCH_MIN_ENTITIES 200
+// above this many entities, they are drawn without their text labels
+#define GUI_LABEL_MAX_ENTITIES 500
+// length of the ticks drawn for a robot's sensors
+#define GUI_SENSOR_TICK 12
+// side of the tiles the entities are sorted in, to only draw those in view
+#define DRAW_TILE_SIZE 64
+// range of the zoom of the arena viewer, in pixels per unit, and its step
+#define GUI_MIN_ZOOM 0.125
+#define GUI_MAX_ZOOM 8
+#define GUI_ZOOM_STEP 1.25
+// below this zoom, no text labels are drawn, and tiles holding at least
+// GUI_DENSITY_MIN_ENTITIES entities are drawn as one square of their mean
+// colour, opaque from GUI_DENSITY_FULL_ENTITIES
+#define GUI_DETAIL_MIN_ZOOM 0.5
+#define GUI_DENSITY_MIN_ENTITIES 8
+#define GUI_DENSITY_FULL_ENTITIES 32
 
-// arena
+// simulation clock
+// simulated seconds per timestep, at a speed of 1
+#define SIMULATION_STEP 0.05
+// wall clock seconds of a frame that may be spent advancing the arena
+#define SIMULATION_FRAME_BUDGET 0.012
+#define SIMULATION_MAX_TICKS_PER_FRAME 100000
+#define SIMULATION_MAX_MULTIPLIER 64
+// commands from the viewer waiting for the simulation thread, a power of 2
+#define SIMULATION_QUEUE_CAPACITY 64
+// wall clock seconds the simulation thread sleeps when no timestep is due
+#define SIMULATION_IDLE_SLEEP 0.001
+
+// arena, default number of each entity
 #define N_LIGHTS 10
 #define N_ROBOTS 10
 #define N_FOOD 10
@@ -90,7 +120,6 @@
 #define LIGHT_SPEED 4
 #define LIGHT_MIN_RADIUS 10
 #define LIGHT_MAX_RADIUS 50
-#define LIGHT_RADIUS random_num(LIGHT_MIN_RADIUS, LIGHT_MAX_RADIUS)
 #define LIGHT_COLOR \
   { 255, 255, 255 }
 #define LIGHT_REVRSE_ANGLE 60
@@ -104,5 +133,26 @@
 #define LEFT_SENSOR -40
 #define MAX_READING 1000
 #define MIN_READING 0
+// a source at distance d adds SENSOR_GAIN / sensitivity^d to a reading
+#define SENSOR_GAIN 1200
+#define FOOD_SENSITIVITY 1.01
+// contributions below this are dropped in the cutoff sensing mode
+#define SENSING_EPSILON 0.01
+// food further than this is also dropped in the cutoff and field sensing
+// modes, 0 for no limit: only food contributing less than the sensing
+// epsilon is dropped, which at SENSING_EPSILON is food further than 1175
+#define FOOD_SENSING_RADIUS 0
+// distance between the nodes of the rasterised stimulus fields
+#define FIELD_CELL_SIZE 4
+// distance a food sensor moves before its reading is computed again
+#define FOOD_SENSING_THRESHOLD 0
+// largest relative error of an interpolated sensor response table
+#define RESPONSE_TABLE_TOLERANCE 1e-6
+// response tables stop where the responses fall below this, and give 0 after
+#define RESPONSE_TABLE_FLOOR 1e-6
+
+// trajectory recording
+// ticks per chunk of a trajectory file, the most deltas summed by a seek
+#define TRAJECTORY_CHUNK_TICKS 256
 
 #endif  // SRC_PARAMS_H_
@@ -10,6 +10,8 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <cmath>
+
 #include "src/common.h"
 
 /*******************************************************************************
@@ -0,0 +1,35 @@
+/**
+ * @file response_mode.h
+ *
+ * @copyright 2018 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_RESPONSE_MODE_H_
+#define SRC_RESPONSE_MODE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/**
+ * kResponseExact computes the response of a sensor to a source,
+ * SENSOR_GAIN / sensitivity^distance, exactly.
+ * kResponseTable interpolates it in a ResponseTable built once per
+ * sensitivity, within RESPONSE_TABLE_TOLERANCE.
+ * kResponsePolynomial computes the responses to the lights with the
+ * polynomial exp2 of AccumulateLightReadings(), within
+ * LIGHT_KERNEL_TOLERANCE, and the responses to food exactly.
+ */
+enum ResponseMode {
+  kResponseExact, kResponseTable, kResponsePolynomial
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_RESPONSE_MODE_H_
@@ -0,0 +1,72 @@
+/**
+ * @file response_table.cc
+ *
+ * @copyright 2018 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cmath>
+
+#include "src/response_table.h"
+#include "src/sensor.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void ResponseTable::Build(double sensitivity, double max_distance,
+  double tolerance) {
+  double log_sensitivity = std::log(sensitivity);
+  // Solve (l h)^2 / 8 * e^(l h) = tolerance, starting from e^(l h) = 1
+  double lh = std::sqrt(8 * tolerance);
+  while (lh * lh / 8 * std::exp(lh) > tolerance) {
+    lh *= 0.99;
+  }
+  sensitivity_ = sensitivity;
+  step_ = lh / log_sensitivity;
+  inv_step_ = 1 / step_;
+  max_error_ = lh * lh / 8 * std::exp(lh);
+
+  double range = std::min(max_distance,
+    Sensor::CutoffDistance(sensitivity, RESPONSE_TABLE_FLOOR));
+  size_t n_steps = static_cast<size_t>(std::ceil(range * inv_step_));
+  range_ = static_cast<double>(n_steps) * step_;
+  last_ = static_cast<double>(n_steps + 1);
+  values_.resize(n_steps + 3);
+  for (size_t k = 0; k <= n_steps; k++) {
+    values_[k] = SENSOR_GAIN /
+      std::pow(sensitivity, static_cast<double>(k) * step_);
+  }
+  values_[n_steps + 1] = 0;
+  values_[n_steps + 2] = 0;
+} /* Build() */
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+void AccumulateTableReadings(const ResponseTable &table, size_t n_sensors,
+  const double *sensor_x, const double *sensor_y, size_t n_sources,
+  const double *source_x, const double *source_y,
+  const double *source_radius, double cutoff, double *readings) {
+  for (size_t i = 0; i < n_sensors; i++) {
+    double reading = readings[i];
+    for (size_t j = 0; j < n_sources; j++) {
+      double distance = Sensor::DistanceToSource(sensor_x[i], sensor_y[i],
+        source_x[j], source_y[j], source_radius[j]);
+      //  Too far away to make a noticeable difference
+      if (distance > cutoff) {
+        continue;
+      }
+      reading = Sensor::AddResponse(reading, table.Response(distance));
+    }
+    readings[i] = reading;
+  }
+} /* AccumulateTableReadings() */
+
+NAMESPACE_END(csci3081);
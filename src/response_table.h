@@ -0,0 +1,119 @@
+/**
+ * @file response_table.h
+ *
+ * @copyright 2018 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_RESPONSE_TABLE_H_
+#define SRC_RESPONSE_TABLE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "src/common.h"
+#include "src/params.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief The response of a sensor of a given sensitivity to a source,
+ * SENSOR_GAIN / sensitivity^distance, tabulated at regular distances and
+ * linearly interpolated.
+ *
+ * With l = ln(sensitivity) and a step h between the tabulated distances, the
+ * interpolation error is at most h^2 / 8 times the largest second derivative
+ * over the step, l^2 times the response at its start, which is e^(l h) times
+ * the response at any distance of the step. Build() picks h so that this
+ * relative error, get_max_error(), is within the given tolerance.
+ *
+ * The table stops at the distance where the response falls below a floor
+ * (RESPONSE_TABLE_FLOOR), or at a maximum distance if that comes first.
+ * Beyond it, the response drops to 0 within one step.
+ */
+class ResponseTable {
+ public:
+  ResponseTable() = default;
+
+  /**
+   * @brief Tabulate the responses of a sensor.
+   *
+   * @param sensitivity The base of the sensor response, greater than 1.
+   * @param max_distance The largest distance the table must cover, e.g. the
+   * diagonal of the arena.
+   * @param tolerance The largest relative error allowed.
+   */
+  void Build(double sensitivity, double max_distance,
+    double tolerance = RESPONSE_TABLE_TOLERANCE);
+
+  /**
+   * @brief The response at a distance, which must not be negative.
+   */
+  double Response(double distance) const {
+    double x = std::min(distance * inv_step_, last_);
+    size_t k = static_cast<size_t>(x);
+    return values_[k] + (x - static_cast<double>(k)) *
+      (values_[k + 1] - values_[k]);
+  }
+
+  double get_sensitivity() const { return sensitivity_; }
+  double get_step() const { return step_; }
+  /**
+   * @brief The largest tabulated distance. The response falls to 0 within one
+   * step past it.
+   */
+  double get_range() const { return range_; }
+  /**
+   * @brief The bound on the relative error of Response() within the range.
+   */
+  double get_max_error() const { return max_error_; }
+  size_t get_size() const { return values_.size(); }
+
+ private:
+  double sensitivity_{0};
+  double step_{1};
+  double inv_step_{1};
+  double range_{0};
+  double max_error_{0};
+  // Index of the first response past the range, as a double
+  double last_{0};
+  // The response every step, then two 0s past the range
+  std::vector<double> values_{0, 0};
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief AccumulateLightReadings() with the responses read from a table:
+ * for each sensor, every source closer than cutoff adds its response to the
+ * reading, which is kept no greater than MAX_READING.
+ *
+ * @param table The responses of the sensors.
+ * @param n_sensors The number of sensors.
+ * @param sensor_x The x position of each sensor.
+ * @param sensor_y The y position of each sensor.
+ * @param n_sources The number of sources.
+ * @param source_x The x position of each source.
+ * @param source_y The y position of each source.
+ * @param source_radius The radius of each source.
+ * @param cutoff Sources further than this from a sensor are ignored.
+ * @param[in,out] readings The reading of each sensor, added to.
+ */
+void AccumulateTableReadings(const ResponseTable &table, size_t n_sensors,
+  const double *sensor_x, const double *sensor_y, size_t n_sources,
+  const double *source_x, const double *source_y,
+  const double *source_radius, double cutoff, double *readings);
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_RESPONSE_TABLE_H_
@@ -0,0 +1,75 @@
+/**
+ * @file rng.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/rng.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+void Philox4x32(const uint32_t counter[4], const uint32_t key[2],
+  uint32_t out[4]) {
+  const uint64_t kMultiplier0 = 0xD2511F53;
+  const uint64_t kMultiplier1 = 0xCD9E8D57;
+  const uint32_t kWeyl0 = 0x9E3779B9;
+  const uint32_t kWeyl1 = 0xBB67AE85;
+
+  uint32_t x0 = counter[0], x1 = counter[1], x2 = counter[2], x3 = counter[3];
+  uint32_t k0 = key[0], k1 = key[1];
+  for (int round = 0; round < 10; round++) {
+    uint64_t product0 = kMultiplier0 * x0;
+    uint64_t product1 = kMultiplier1 * x2;
+    uint32_t hi0 = static_cast<uint32_t>(product0 >> 32);
+    uint32_t lo0 = static_cast<uint32_t>(product0);
+    uint32_t hi1 = static_cast<uint32_t>(product1 >> 32);
+    uint32_t lo1 = static_cast<uint32_t>(product1);
+    x0 = hi1 ^ x1 ^ k0;
+    x1 = lo1;
+    x2 = hi0 ^ x3 ^ k1;
+    x3 = lo0;
+    k0 += kWeyl0;
+    k1 += kWeyl1;
+  }
+  out[0] = x0;
+  out[1] = x1;
+  out[2] = x2;
+  out[3] = x3;
+}
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+RandomStream::RandomStream(uint64_t seed, uint32_t a, uint32_t b, uint32_t c)
+    : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+      counter_{0, c, b, a},
+      block_{0, 0, 0, 0} {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+uint32_t RandomStream::NextUint() {
+  if (used_ == 4) {
+    Philox4x32(counter_, key_, block_);
+    counter_[0]++;
+    used_ = 0;
+  }
+  return block_[used_++];
+}
+
+double RandomStream::NextDouble() {
+  uint64_t high = NextUint() >> 5;
+  uint64_t low = NextUint() >> 6;
+  return static_cast<double>((high << 26) | low) / 9007199254740992.0;
+}
+
+NAMESPACE_END(csci3081);
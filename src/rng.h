@@ -0,0 +1,112 @@
+/**
+ * @file rng.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_RNG_H_
+#define SRC_RNG_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+
+#include "src/common.h"
+#include "src/entity_type.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief The Philox4x32-10 block function: encrypts counter with key into 4
+ * random words (Salmon et al., "Parallel random numbers: as easy as 1, 2,
+ * 3", SC 2011).
+ */
+void Philox4x32(const uint32_t counter[4], const uint32_t key[2],
+  uint32_t out[4]);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A sequence of random numbers, drawn from Philox4x32-10 blocks.
+ *
+ * The stream is identified by a seed and three words; the numbers it gives
+ * only depend on these and on how many numbers were drawn before, so streams
+ * can be created in any order, on any thread.
+ */
+class RandomStream {
+ public:
+  RandomStream(uint64_t seed, uint32_t a, uint32_t b, uint32_t c);
+
+  /**
+   * @brief The next 32 random bits.
+   */
+  uint32_t NextUint();
+
+  /**
+   * @brief A random number in [0, 1), with 53 random bits.
+   */
+  double NextDouble();
+
+  /**
+   * @brief A random number in [min, max), converted to T (i.e. truncated
+   * for integer types).
+   */
+  template <typename T>
+  T Uniform(T min, T max) {
+    double lower = static_cast<double>(min);
+    return static_cast<T>(lower + (static_cast<double>(max) - lower) *
+      NextDouble());
+  }
+
+  /**
+   * @brief A random integer in [0, n).
+   */
+  int Index(int n) { return static_cast<int>(NextDouble() * n); }
+
+ private:
+  uint32_t key_[2];
+  // word 0 counts the blocks, words 1-3 identify the stream
+  uint32_t counter_[4];
+  uint32_t block_[4];
+  // words of block_ already used
+  int used_{4};
+};
+
+/**
+ * @brief The random number generator of an Arena.
+ *
+ * Every random decision about an entity is drawn from that entity's own
+ * stream, keyed by the entity type, its id and an epoch (0 at creation,
+ * then incremented at every reset of the Arena). Two Arenas with the same
+ * seed therefore make the same decisions, whatever the order in which the
+ * entities are processed and whatever the number of threads.
+ */
+class Rng {
+ public:
+  explicit Rng(uint64_t seed) : seed_(seed) {}
+
+  /**
+   * @brief The stream of an entity for an epoch.
+   */
+  RandomStream Stream(EntityType type, int id, uint32_t epoch) const {
+    return RandomStream(seed_, static_cast<uint32_t>(type),
+      static_cast<uint32_t>(id), epoch);
+  }
+
+  uint64_t get_seed() const { return seed_; }
+
+ private:
+  uint64_t seed_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_RNG_H_
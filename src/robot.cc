@@ -42,13 +42,24 @@ NAMESPACE_BEGIN(csci3081);
       is_reverse_arc{false},
       direc_angle_{180},
       hungry_t_{0},
-      status_{PLAYING} {
+      status_{PLAYING},
+      fear_handler_(this),
+      explore_handler_(this),
+      motion_handler_(&fear_handler_) {
     set_type(kRobot);
     set_color(ROBOT_COLOR);
-    motion_handler_ = new MotionHandlerFear(this);
   }
 
 void Robot::TimestepUpdate(unsigned int dt) {
+  UpdateVelocity();
+  // When the robot is not dead
+  if (!is_dead()) {
+  // Use velocity and position to update position
+    motion_behavior_.UpdatePose(dt, motion_handler_->get_velocity());
+  }
+} /* TimestepUpdate() */
+
+void Robot::UpdateVelocity() {
   // When the robot is not dead
   if (!is_dead()) {
   //  When doing a reverse arc
@@ -60,24 +71,20 @@ void Robot::TimestepUpdate(unsigned int dt) {
       light_sensor_right_.get_reading(), food_sensor_left_.get_reading(),
       food_sensor_right_.get_reading(), hungry_t_, food_exist_);
     }
-
-  // Use velocity and position to update position
-    motion_behavior_.UpdatePose(dt, motion_handler_->get_velocity());
-
   } else {
     set_status(LOST);
   }
-} /* TimestepUpdate() */
+} /* UpdateVelocity() */
 
 
-void Robot::Reset() {
-  Pose robot_pose = {static_cast<double>((30+(random()%19)*50)),
-       static_cast<double>((30+(random()%14)*50))};
+void Robot::Reset(RandomStream *random) {
+  Pose robot_pose = {static_cast<double>((30+(random->Index(19))*50)),
+       static_cast<double>((30+(random->Index(14))*50))};
   set_pose(robot_pose);
   motion_handler_->set_max_speed(ROBOT_MAX_SPEED);
   motion_handler_->set_max_angle(ROBOT_MAX_ANGLE);
-  set_heading(random_num(0, 360));
-  set_radius(random_num(8, 14));
+  set_heading(random->Uniform(0, 360));
+  set_radius(random->Uniform(8, 14));
   motion_handler_->set_velocity(0, 0);
   reset_hungry_counter();
   reset_sensor_reading();
@@ -86,6 +93,56 @@ void Robot::Reset() {
   set_status(PLAYING);
 } /* Reset() */
 
+void Robot::BindStore(EntityStore *store, size_t row) {
+  ArenaMobileEntity::BindStore(store, row);
+  set_light_sensitivity(get_light_sensitivity());
+} /* BindStore() */
+
+void Robot::SaveState(std::ostream &out) const {
+  ArenaMobileEntity::SaveState(out);
+  bool explores = (kExplorer == behavior_);
+  WheelVelocity velocity = motion_handler_->get_velocity();
+  WriteValue(out, static_cast<int32_t>(type_));
+  WriteValue(out, static_cast<uint8_t>(explores));
+  WriteValue(out, velocity.left);
+  WriteValue(out, velocity.right);
+  WriteValue(out, get_light_sensitivity());
+  WriteValue(out, static_cast<uint8_t>(is_reverse_arc));
+  WriteValue(out, static_cast<int32_t>(direc_angle_));
+  WriteValue(out, static_cast<int32_t>(hungry_t_));
+  WriteValue(out, static_cast<int32_t>(status_));
+  WriteValue(out, static_cast<uint8_t>(food_exist_));
+} /* SaveState() */
+
+bool Robot::LoadState(std::istream &in) {
+  int32_t type = 0, direc_angle = 0, hungry = 0, status = 0;
+  uint8_t explores = 0, reverse_arc = 0, food_exist = 0;
+  double left = 0, right = 0, sensitivity = 0;
+  if (!ArenaMobileEntity::LoadState(in) || !ReadValue(in, &type) ||
+      !ReadValue(in, &explores) || !ReadValue(in, &left) ||
+      !ReadValue(in, &right) || !ReadValue(in, &sensitivity) ||
+      !ReadValue(in, &reverse_arc) || !ReadValue(in, &direc_angle) ||
+      !ReadValue(in, &hungry) || !ReadValue(in, &status) ||
+      !ReadValue(in, &food_exist)) {
+    return false;
+  }
+  type_ = static_cast<RobotType>(type);
+  bool explored = (kExplorer == behavior_);
+  if (explores && !explored) {
+    ChangeToExplore();
+  } else if (!explores && explored) {
+    ChangeToFear();
+  }
+  motion_handler_->set_velocity(left, right);
+  set_light_sensitivity(sensitivity);
+  is_reverse_arc = (reverse_arc != 0);
+  direc_angle_ = direc_angle;
+  hungry_t_ = hungry;
+  status_ = status;
+  food_exist_ = (food_exist != 0);
+  return true;
+} /* LoadState() */
+
 void Robot::HandleCollision() {
 is_reverse_arc = true;  // Starts to move in a reverse arc
 }
@@ -107,13 +164,8 @@ void Robot::ReverseArc() {
 }
 
 bool Robot::IsFeeding(Pose food_pose, double food_radius) {
-  double delta_x = get_pose().x - food_pose.x;
-  double delta_y = get_pose().y - food_pose.y;
-  // distance between robot and food
-  double distance_between = sqrt(delta_x*delta_x + delta_y*delta_y)
-  -food_radius - get_radius();
-  // if the robot is feed by food, distace should be within 5
-  return(distance_between <= 5 );
+  return IsWithinFeedingRange(get_pose().x, get_pose().y, get_radius(),
+    food_pose.x, food_pose.y, food_radius);
 }
 
 
@@ -134,11 +186,17 @@ void Robot::FoodNotify(Pose food_pose, double food_radius) {
 
 
 void Robot::ChangeToExplore() {
-  motion_handler_ = new MotionHandlerExplore(this);
+  explore_handler_ = MotionHandlerExplore(this);
+  motion_handler_ = &explore_handler_;
+  motion_handler_->set_velocity(0, 0);
+  behavior_ = kExplorer;
 }
 
 void Robot::ChangeToFear() {
-  motion_handler_ = new MotionHandlerFear(this);
+  fear_handler_ = MotionHandlerFear(this);
+  motion_handler_ = &fear_handler_;
+  motion_handler_->set_velocity(0, 0);
+  behavior_ = kFear;
 }
 
 
@@ -16,6 +16,7 @@
 #include "src/common.h"
 #include "src/motion_handler_fear.h"
 #include "src/motion_handler_explore.h"
+#include "src/robot_policy.h"
 #include "src/motion_behavior_differential.h"
 #include "src/entity_type.h"
 #include "src/light_sensor.h"
@@ -64,7 +65,24 @@ class Robot : public ArenaMobileEntity {
    * @brief Reset the Robot to a newly constructed state (needed for reset
    * button to work in GUI).
    */
-  void Reset() override;
+  void Reset(RandomStream *random) override;
+
+  /**
+   * @brief Move the light sensitivity to the store along with the pose.
+   */
+  void BindStore(EntityStore *store, size_t row) override;
+
+  /**
+   * @brief Write the type, motion handler, wheel velocities, reverse arc,
+   * hunger and game status of the Robot to a checkpoint.
+   */
+  void SaveState(std::ostream &out) const override;
+
+  /**
+   * @brief Read back the state written by SaveState(). The motion handler
+   * is switched if the checkpoint has the other one.
+   */
+  bool LoadState(std::istream &in) override;
 
   /**
    * @brief Update the Robot's position and velocity after the specified
@@ -74,6 +92,13 @@ class Robot : public ArenaMobileEntity {
    */
   void TimestepUpdate(unsigned int dt) override;
 
+  /**
+   * @brief The first half of TimestepUpdate(): pick the wheel velocities
+   * from the sensor readings (or continue the reverse arc), without moving.
+   * A dead robot does not move and gets the LOST status instead.
+   */
+  void UpdateVelocity();
+
 
   /**
    * @brief Handles the collision by setting the sensor to activated.
@@ -108,10 +133,18 @@ class Robot : public ArenaMobileEntity {
    * @return the pose of the sensor
    */
   Pose get_sensor_position(double angle) {
-    double theta = get_pose().theta + angle;
+    return SensorPosition(get_pose(), get_radius(), angle);
+  }
+
+  /**
+   * @brief Position of a sensor on the edge of a robot with the given pose
+   * and radius.
+   */
+  static Pose SensorPosition(const Pose &pose, double radius, double angle) {
+    double theta = pose.theta + angle;
     double theta2 = theta*M_PI/180.0;
-    double x = get_radius()*cos(theta2) + get_pose().x;
-    double y = get_radius()*sin(theta2) + get_pose().y;
+    double x = radius*cos(theta2) + pose.x;
+    double y = radius*sin(theta2) + pose.y;
     return Pose(x, y, theta);
   }
 
@@ -134,7 +167,7 @@ class Robot : public ArenaMobileEntity {
 
   /**
    * @brief Change the motion handler to MotionHandlerExplore for those robots
-   * of type kExplorer.
+   * of type kExplorer. The handler starts afresh, as a new one would.
    */
   void ChangeToExplore();
 
@@ -152,6 +185,20 @@ class Robot : public ArenaMobileEntity {
    */
   bool IsFeeding(Pose food_pose, double food_radius);
 
+  /**
+   * @brief IsFeeding() for a robot at (x, y) of the given radius.
+   */
+  static bool IsWithinFeedingRange(double x, double y, double radius,
+    double food_x, double food_y, double food_radius) {
+    double delta_x = x - food_x;
+    double delta_y = y - food_y;
+    // distance between robot and food
+    double distance_between = sqrt(delta_x*delta_x + delta_y*delta_y)
+    -food_radius - radius;
+    // if the robot is feed by food, distace should be within 5
+    return(distance_between <= 5);
+  }
+
  /**
   * @brief Set all sensor readings to 0.
   */
@@ -162,6 +209,18 @@ class Robot : public ArenaMobileEntity {
     food_sensor_right_.zero_reading();
   }
 
+  /**
+   * @brief Set all sensor readings at once. Used by the Arena, which computes
+   * the readings of every robot in one pass.
+   */
+  void set_sensor_readings(double lt_left, double lt_right, double fd_left,
+    double fd_right) {
+    light_sensor_left_.set_reading(lt_left);
+    light_sensor_right_.set_reading(lt_right);
+    food_sensor_left_.set_reading(fd_left);
+    food_sensor_right_.set_reading(fd_right);
+  }
+
   /**
    * @brief get light sensor reading, for unit test.
    * @param direction Angle that the sensor is located at from the robot's
@@ -197,6 +256,24 @@ class Robot : public ArenaMobileEntity {
   void set_light_sensitivity(double sense) {
     light_sensor_left_.set_sensitivity(sense);
     light_sensor_right_.set_sensitivity(sense);
+    if (get_store()) {
+      get_store()->light_sensitivity[get_store_row()] = sense;
+    }
+  }
+
+  double get_light_sensitivity() const {
+    return light_sensor_left_.get_sensitivity();
+  }
+
+  /**
+   * @brief Ignore light and food further than the given distances from the
+   * sensors. Pass infinity to sense everything.
+   */
+  void set_sensing_cutoff(double light_cutoff, double food_cutoff) {
+    light_sensor_left_.set_cutoff_distance(light_cutoff);
+    light_sensor_right_.set_cutoff_distance(light_cutoff);
+    food_sensor_left_.set_cutoff_distance(food_cutoff);
+    food_sensor_right_.set_cutoff_distance(food_cutoff);
   }
 
   /**
@@ -222,6 +299,14 @@ class Robot : public ArenaMobileEntity {
     hungry_t_ = 0;
   }
 
+  /**
+   * @brief hungry counter getter.
+   * return the number of timesteps since the robot last ate.
+   */
+  int get_hungry_counter() const {
+    return hungry_t_;
+  }
+
   /**
    * @brief Determine if a robot is dead by check robot's hungry level.
    */
@@ -255,6 +340,22 @@ class Robot : public ArenaMobileEntity {
     food_exist_ = food_exist;
   }
 
+  /**
+   * @brief The hunger band the motion handler goes by at the current hungry
+   * level.
+   */
+  HungerBand get_hunger_band() const {
+    return GetHungerBand(hungry_t_, food_exist_);
+  }
+
+  /**
+   * @brief The behaviour of the motion handler: kExplorer after
+   * ChangeToExplore(), kFear otherwise.
+   */
+  RobotType get_behavior() const {
+    return behavior_;
+  }
+
   double get_left_velocity() {
     return motion_handler_->get_left_velocity();
   }
@@ -267,6 +368,13 @@ class Robot : public ArenaMobileEntity {
     return motion_handler_;
   }
 
+  /**
+   * @brief Whether the robot is turning away from a collision.
+   */
+  bool is_reverse_arcing() const {
+    return is_reverse_arc;
+  }
+
 
 
  private:
@@ -283,6 +391,8 @@ class Robot : public ArenaMobileEntity {
 
   // Type of the robot
   RobotType type_;
+  // Behaviour of motion_handler_
+  RobotType behavior_{kFear};
   // Determine whether the robot is moving in a reverse arc
   bool is_reverse_arc;
   // the reverse arc motion counter
@@ -295,7 +405,12 @@ class Robot : public ArenaMobileEntity {
   bool food_exist_{true};
 
  protected:
+  // The handlers of both behaviours, held by value so that changing behaviour
+  // does not allocate.
+  MotionHandlerFear fear_handler_;
+  MotionHandlerExplore explore_handler_;
   // Manages pose and wheel velocities that change with time and collisions.
+  // Points to the handler of the current behaviour.
   MotionHandler * motion_handler_ {nullptr};
 };
 
@@ -0,0 +1,49 @@
+/**
+ * @file robot_policy.cc
+ *
+ * @copyright 2018 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/robot_policy.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/* One pass over the batch, with the policy and hunger band compiled in */
+template <class Policy, HungerBand kBand>
+static void RunPolicy(size_t n, const controller_batch &batch) {
+  for (size_t i = 0; i < n; i++) {
+    PolicyWheelSpeeds<Policy, kBand>(batch.light_left[i],
+      batch.light_right[i], batch.food_left[i], batch.food_right[i],
+      batch.max_speed[i], &batch.vel_left[i], &batch.vel_right[i]);
+  }
+}
+
+/* The kernels of a policy, indexed by HungerBand */
+#define POLICY_KERNELS(Policy) \
+  { RunPolicy<Policy, kSated>, RunPolicy<Policy, kHungry>, \
+    RunPolicy<Policy, kStarving> }
+
+ControllerKernel ControllerKernelFor(RobotType behavior, HungerBand band) {
+  // Indexed by RobotType. A new behaviour adds its policy here.
+  static const ControllerKernel kKernels[kBehaviorCount][kHungerBandCount] =
+  {
+    POLICY_KERNELS(FearPolicy),      // kFear
+    POLICY_KERNELS(ExplorePolicy),   // kExplorer
+  };
+  size_t row = static_cast<size_t>(behavior);
+  if (row >= kBehaviorCount) {
+    row = kFear;
+  }
+  return kKernels[row][band];
+} /* ControllerKernelFor() */
+
+NAMESPACE_END(csci3081);
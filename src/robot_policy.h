@@ -0,0 +1,213 @@
+/**
+ * @file robot_policy.h
+ *
+ * @copyright 2018 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_ROBOT_POLICY_H_
+#define SRC_ROBOT_POLICY_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cstddef>
+
+#include "src/common.h"
+#include "src/params.h"
+#include "src/robot_type.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Type Definitions
+ ******************************************************************************/
+/**
+ * @brief How hungry a robot is, as far as its controller is concerned.
+ */
+enum HungerBand {
+  kSated,     // not hungry, or no food in the arena
+  kHungry,    // hungry, but not starving
+  kStarving,  // only goes for food
+  kHungerBandCount
+};
+
+/**
+ * @brief The # of robot behaviours with a policy: kFear and kExplorer.
+ */
+const size_t kBehaviorCount = 2;
+
+/**
+ * @brief The controller inputs and outputs of a batch of robots, one array
+ * element per robot.
+ */
+struct controller_batch {
+  const double *light_left{nullptr};
+  const double *light_right{nullptr};
+  const double *food_left{nullptr};
+  const double *food_right{nullptr};
+  const double *max_speed{nullptr};
+  double *vel_left{nullptr};
+  double *vel_right{nullptr};
+};
+
+/**
+ * @brief Compute the wheel velocities of n robots of a batch.
+ */
+typedef void (*ControllerKernel)(size_t n, const controller_batch &batch);
+
+/*******************************************************************************
+ * Policies
+ ******************************************************************************/
+/*
+ * A policy is a class of static functions giving the wheel speeds of one
+ * robot behaviour, before they are clamped to the maximum speed:
+ *
+ *   LightLeft/LightRight  the speeds when the robot is not hungry
+ *   FoodLeft/FoodRight    the speeds when the robot is starving
+ *   kHungryLightShare,    the weights of the (clamped) light and food speeds
+ *   kHungryFoodShare      when the robot is hungry
+ *
+ * A new behaviour is a new policy, added to the table of kernels in
+ * robot_policy.cc, where it is compiled once per hunger band.
+ */
+
+/**
+ * @brief Both behaviours go straight for the food they sense, crossing the
+ * food sensors to the wheels.
+ */
+struct AggressiveFoodPolicy {
+  static double FoodLeft(__unused double food_left, double food_right) {
+    return 10 * (food_right / 1000);
+  }
+  static double FoodRight(double food_left, __unused double food_right) {
+    return 10 * (food_left / 1000);
+  }
+};
+
+/**
+ * @brief MotionHandlerFear: runs away from the lights.
+ */
+struct FearPolicy : public AggressiveFoodPolicy {
+  static constexpr double kHungryLightShare = 0.6;
+  static constexpr double kHungryFoodShare = 0.4;
+
+  static double LightLeft(double light_left, __unused double light_right) {
+    return 10 * (light_left / 1000);
+  }
+  static double LightRight(__unused double light_left, double light_right) {
+    return 10 * (light_right / 1000);
+  }
+};
+
+/**
+ * @brief MotionHandlerExplore: slows down near the lights, turning toward
+ * them.
+ */
+struct ExplorePolicy : public AggressiveFoodPolicy {
+  static constexpr double kHungryLightShare = 0.5;
+  static constexpr double kHungryFoodShare = 0.5;
+
+  static double LightLeft(__unused double light_left, double light_right) {
+    return 10 * (1 - light_right / 1000);
+  }
+  static double LightRight(double light_left, __unused double light_right) {
+    return 10 * (1 - light_left / 1000);
+  }
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief The hunger band of a robot at the given hungry level.
+ */
+inline HungerBand GetHungerBand(int hungry_level, bool food_exist) {
+  if (!food_exist || hungry_level <= HUNGRY) {
+    return kSated;
+  }
+  return (hungry_level < STARVE) ? kHungry : kStarving;
+}
+
+/**
+ * @brief Keep a wheel speed within [-max_speed, max_speed].
+ */
+inline double ClampSpeed(double speed, double max_speed) {
+  return std::min(std::max(speed, -max_speed), max_speed);
+}
+
+/**
+ * @brief The wheel velocities given by Policy to one robot in band kBand.
+ *
+ * kBand is known at compile time, so each instantiation only computes the
+ * speeds it uses, without branching.
+ */
+template <class Policy, HungerBand kBand>
+inline void PolicyWheelSpeeds(double light_left, double light_right,
+  double food_left, double food_right, double max_speed, double *vel_left,
+  double *vel_right) {
+  if (kSated == kBand) {
+    *vel_left = ClampSpeed(Policy::LightLeft(light_left, light_right),
+      max_speed);
+    *vel_right = ClampSpeed(Policy::LightRight(light_left, light_right),
+      max_speed);
+  } else if (kStarving == kBand) {
+    *vel_left = ClampSpeed(Policy::FoodLeft(food_left, food_right),
+      max_speed);
+    *vel_right = ClampSpeed(Policy::FoodRight(food_left, food_right),
+      max_speed);
+  } else {
+    double light_l = ClampSpeed(Policy::LightLeft(light_left, light_right),
+      max_speed);
+    double light_r = ClampSpeed(Policy::LightRight(light_left, light_right),
+      max_speed);
+    double food_l = ClampSpeed(Policy::FoodLeft(food_left, food_right),
+      max_speed);
+    double food_r = ClampSpeed(Policy::FoodRight(food_left, food_right),
+      max_speed);
+    *vel_left = ClampSpeed(Policy::kHungryLightShare * light_l +
+      Policy::kHungryFoodShare * food_l, max_speed);
+    *vel_right = ClampSpeed(Policy::kHungryLightShare * light_r +
+      Policy::kHungryFoodShare * food_r, max_speed);
+  }
+}
+
+/**
+ * @brief PolicyWheelSpeeds() for a hunger band known at run time, for the
+ * motion handlers, which control one robot at a time.
+ */
+template <class Policy>
+inline void PolicyWheelSpeeds(HungerBand band, double light_left,
+  double light_right, double food_left, double food_right, double max_speed,
+  double *vel_left, double *vel_right) {
+  switch (band) {
+    case kHungry:
+      PolicyWheelSpeeds<Policy, kHungry>(light_left, light_right, food_left,
+        food_right, max_speed, vel_left, vel_right);
+      break;
+    case kStarving:
+      PolicyWheelSpeeds<Policy, kStarving>(light_left, light_right,
+        food_left, food_right, max_speed, vel_left, vel_right);
+      break;
+    default:
+      PolicyWheelSpeeds<Policy, kSated>(light_left, light_right, food_left,
+        food_right, max_speed, vel_left, vel_right);
+      break;
+  }
+}
+
+/**
+ * @brief The kernel computing the wheel velocities of a batch of robots
+ * that all have the given behaviour and hunger band.
+ *
+ * @param behavior One of the first kBehaviorCount robot types; any other is
+ * controlled as kFear, like a newly constructed Robot.
+ */
+ControllerKernel ControllerKernelFor(RobotType behavior, HungerBand band);
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_ROBOT_POLICY_H_
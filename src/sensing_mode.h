@@ -0,0 +1,34 @@
+/**
+ * @file sensing_mode.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_SENSING_MODE_H_
+#define SRC_SENSING_MODE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/**
+ * kSenseAll notifies every robot of every light and food.
+ * kSenseCutoff ignores the sources whose contribution to a reading is below
+ * the sensing epsilon, and finds the remaining ones through a spatial grid.
+ * kSenseField ignores the same sources, and reads the sum of the others from
+ * a field rasterised on a grid once per timestep (see StimulusField), for
+ * robots far more numerous than the lights and food.
+ */
+enum SensingMode {
+  kSenseAll, kSenseCutoff, kSenseField
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_SENSING_MODE_H_
@@ -10,6 +10,8 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <cmath>
+#include <limits>
 #include <utility>
 #include <vector>
 #include <iostream>
@@ -84,12 +86,64 @@ class Sensor {
    */
   void zero_reading() {reading_ = 0;}
 
+  /**
+   * @brief Sources further than this distance from the sensor are ignored.
+   * Infinite (nothing ignored) by default.
+   */
+  void set_cutoff_distance(double distance) { cutoff_distance_ = distance; }
+  double get_cutoff_distance() const { return cutoff_distance_; }
+
+  /**
+   * @brief Distance beyond which a source adds less than epsilon to a
+   * reading, i.e. the d solving SENSOR_GAIN / sensitivity^d = epsilon.
+   * @param sensitivity The base of the sensor response.
+   * @param epsilon The smallest contribution worth adding.
+   */
+  static double CutoffDistance(double sensitivity, double epsilon) {
+    return std::log(SENSOR_GAIN / epsilon) / std::log(sensitivity);
+  }
+
+  /**
+   * @brief Distance between a sensor and the edge of a source, 0 if the
+   * sensor is inside the source.
+   */
+  static double DistanceToSource(double sensor_x, double sensor_y,
+    double source_x, double source_y, double source_radius) {
+    double delta_x = sensor_x - source_x;
+    double delta_y = sensor_y - source_y;
+    double distance_between = sqrt(delta_x*delta_x + delta_y*delta_y)
+    - source_radius;
+    if (distance_between < 0) {
+      distance_between = 0;
+    }
+    return distance_between;
+  }
+
+  /**
+   * @brief Add the contribution of a source at the given distance to a
+   * reading, keeping the result no greater than the maximum reading.
+   */
+  static double AddContribution(double reading, double sensitivity,
+    double distance) {
+    return AddResponse(reading, SENSOR_GAIN/(pow(sensitivity, distance)));
+  }
+
+  /**
+   * @brief Add a response already computed (e.g. by a ResponseTable) to a
+   * reading, keeping the result no greater than the maximum reading.
+   */
+  static double AddResponse(double reading, double response) {
+    double reading_to_set = reading + response;
+    return (reading_to_set > MAX_READING) ? MAX_READING : reading_to_set;
+  }
 
  private:
   // type of the current sensor
   SensorType sensor_type_ {kLightSensor};
   // the current sensor reading
   double reading_ {0};
+  // sources further than this are ignored
+  double cutoff_distance_ {std::numeric_limits<double>::infinity()};
 };
 
 
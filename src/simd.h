@@ -0,0 +1,172 @@
+/**
+ * @file simd.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_SIMD_H_
+#define SRC_SIMD_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Vector Operations
+ ******************************************************************************/
+/*
+ * The batched kernels are written once against the few operations below,
+ * which map to AVX2, SSE2 or plain doubles depending on the target. A Vec
+ * holds kLanes doubles. Comparisons give masks, with every bit of a lane set
+ * where the comparison holds. The *Int operations treat each lane as a 64
+ * bit integer.
+ *
+ * A kernel runs its batch in blocks of kLanes elements, and pads the last,
+ * partial block with zeros to a full one. Every element then goes through
+ * the same instructions wherever it is in the batch, so its result does not
+ * depend on the size of the batch.
+ */
+#if defined(__AVX2__)
+typedef __m256d Vec;
+static const size_t kLanes = 4;
+static inline Vec Load(const double *p) { return _mm256_loadu_pd(p); }
+static inline void Store(double *p, Vec v) { _mm256_storeu_pd(p, v); }
+static inline Vec Set1(double a) { return _mm256_set1_pd(a); }
+static inline Vec Add(Vec a, Vec b) { return _mm256_add_pd(a, b); }
+static inline Vec Sub(Vec a, Vec b) { return _mm256_sub_pd(a, b); }
+static inline Vec Mul(Vec a, Vec b) { return _mm256_mul_pd(a, b); }
+static inline Vec Div(Vec a, Vec b) { return _mm256_div_pd(a, b); }
+static inline Vec Min(Vec a, Vec b) { return _mm256_min_pd(a, b); }
+static inline Vec Max(Vec a, Vec b) { return _mm256_max_pd(a, b); }
+static inline Vec Sqrt(Vec a) { return _mm256_sqrt_pd(a); }
+static inline Vec And(Vec a, Vec b) { return _mm256_and_pd(a, b); }
+// ~a & b
+static inline Vec AndNot(Vec a, Vec b) { return _mm256_andnot_pd(a, b); }
+static inline Vec Or(Vec a, Vec b) { return _mm256_or_pd(a, b); }
+static inline Vec Xor(Vec a, Vec b) { return _mm256_xor_pd(a, b); }
+static inline Vec Greater(Vec a, Vec b) {
+  return _mm256_cmp_pd(a, b, _CMP_GT_OQ);
+}
+static inline Vec SetBits(uint64_t a) {
+  return _mm256_castsi256_pd(_mm256_set1_epi64x(static_cast<int64_t>(a)));
+}
+static inline Vec AddInt(Vec a, int64_t n) {
+  return _mm256_castsi256_pd(_mm256_add_epi64(_mm256_castpd_si256(a),
+    _mm256_set1_epi64x(n)));
+}
+static inline Vec NegInt(Vec a) {
+  return _mm256_castsi256_pd(_mm256_sub_epi64(_mm256_setzero_si256(),
+    _mm256_castpd_si256(a)));
+}
+static inline Vec ShiftLeftInt(Vec a, int n) {
+  return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(a), n));
+}
+#elif defined(__SSE2__)
+typedef __m128d Vec;
+static const size_t kLanes = 2;
+static inline Vec Load(const double *p) { return _mm_loadu_pd(p); }
+static inline void Store(double *p, Vec v) { _mm_storeu_pd(p, v); }
+static inline Vec Set1(double a) { return _mm_set1_pd(a); }
+static inline Vec Add(Vec a, Vec b) { return _mm_add_pd(a, b); }
+static inline Vec Sub(Vec a, Vec b) { return _mm_sub_pd(a, b); }
+static inline Vec Mul(Vec a, Vec b) { return _mm_mul_pd(a, b); }
+static inline Vec Div(Vec a, Vec b) { return _mm_div_pd(a, b); }
+static inline Vec Min(Vec a, Vec b) { return _mm_min_pd(a, b); }
+static inline Vec Max(Vec a, Vec b) { return _mm_max_pd(a, b); }
+static inline Vec Sqrt(Vec a) { return _mm_sqrt_pd(a); }
+static inline Vec And(Vec a, Vec b) { return _mm_and_pd(a, b); }
+static inline Vec AndNot(Vec a, Vec b) { return _mm_andnot_pd(a, b); }
+static inline Vec Or(Vec a, Vec b) { return _mm_or_pd(a, b); }
+static inline Vec Xor(Vec a, Vec b) { return _mm_xor_pd(a, b); }
+static inline Vec Greater(Vec a, Vec b) { return _mm_cmpgt_pd(a, b); }
+static inline Vec SetBits(uint64_t a) {
+  return _mm_castsi128_pd(_mm_set1_epi64x(static_cast<int64_t>(a)));
+}
+static inline Vec AddInt(Vec a, int64_t n) {
+  return _mm_castsi128_pd(_mm_add_epi64(_mm_castpd_si128(a),
+    _mm_set1_epi64x(n)));
+}
+static inline Vec NegInt(Vec a) {
+  return _mm_castsi128_pd(_mm_sub_epi64(_mm_setzero_si128(),
+    _mm_castpd_si128(a)));
+}
+static inline Vec ShiftLeftInt(Vec a, int n) {
+  return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(a), n));
+}
+#else
+typedef double Vec;
+static const size_t kLanes = 1;
+static inline uint64_t ToBits(Vec a) {
+  uint64_t bits;
+  std::memcpy(&bits, &a, sizeof(bits));
+  return bits;
+}
+static inline Vec FromBits(uint64_t bits) {
+  Vec a;
+  std::memcpy(&a, &bits, sizeof(bits));
+  return a;
+}
+static inline Vec Load(const double *p) { return *p; }
+static inline void Store(double *p, Vec v) { *p = v; }
+static inline Vec Set1(double a) { return a; }
+static inline Vec Add(Vec a, Vec b) { return a + b; }
+static inline Vec Sub(Vec a, Vec b) { return a - b; }
+static inline Vec Mul(Vec a, Vec b) { return a * b; }
+static inline Vec Div(Vec a, Vec b) { return a / b; }
+static inline Vec Min(Vec a, Vec b) { return (b < a) ? b : a; }
+static inline Vec Max(Vec a, Vec b) { return (b > a) ? b : a; }
+static inline Vec Sqrt(Vec a) { return std::sqrt(a); }
+static inline Vec And(Vec a, Vec b) { return FromBits(ToBits(a) & ToBits(b)); }
+static inline Vec AndNot(Vec a, Vec b) {
+  return FromBits(~ToBits(a) & ToBits(b));
+}
+static inline Vec Or(Vec a, Vec b) { return FromBits(ToBits(a) | ToBits(b)); }
+static inline Vec Xor(Vec a, Vec b) { return FromBits(ToBits(a) ^ ToBits(b)); }
+static inline Vec Greater(Vec a, Vec b) {
+  return FromBits((a > b) ? ~uint64_t{0} : 0);
+}
+static inline Vec SetBits(uint64_t a) { return FromBits(a); }
+static inline Vec AddInt(Vec a, int64_t n) {
+  return FromBits(ToBits(a) + static_cast<uint64_t>(n));
+}
+static inline Vec NegInt(Vec a) { return FromBits(0 - ToBits(a)); }
+static inline Vec ShiftLeftInt(Vec a, int n) {
+  return FromBits(ToBits(a) << n);
+}
+#endif
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+// a where mask is set, b elsewhere
+static inline Vec Select(Vec mask, Vec a, Vec b) {
+  return Or(And(mask, a), AndNot(mask, b));
+}
+
+static inline Vec Abs(Vec a) { return AndNot(Set1(-0.0), a); }
+
+/*
+ * Adding then subtracting this rounds a double of magnitude below 2^51 to the
+ * nearest integer. In between, the integer is held, two's complement, in the
+ * low bits of the mantissa.
+ */
+static const double kRoundingShift = 6755399441055744.0;  // 1.5 * 2^52
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_SIMD_H_
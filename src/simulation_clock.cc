@@ -0,0 +1,72 @@
+/**
+ * @file simulation_clock.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+
+#include "src/simulation_clock.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+SimulationClock::SimulationClock(double step, double frame_budget)
+    : step_(step), frame_budget_(frame_budget) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+int SimulationClock::get_max_ticks() const {
+  // Until a timestep has been measured, run one per frame.
+  if (!(tick_seconds_ > 0)) {
+    return 1;
+  }
+  // Timesteps are almost free once the game is over, so bound the estimate.
+  double fit = std::min(frame_budget_ / tick_seconds_,
+    static_cast<double>(SIMULATION_MAX_TICKS_PER_FRAME));
+  return std::max(1, static_cast<int>(fit));
+} /* get_max_ticks() */
+
+int SimulationClock::TicksDue(double dt) {
+  int max_ticks = get_max_ticks();
+  if (fast_forward_) {
+    accumulator_ = 0;
+    return max_ticks;
+  }
+  if (!(step_ > 0) || !(dt > 0)) {
+    return 0;
+  }
+  accumulator_ += dt * multiplier_;
+  double due = accumulator_ / step_;
+  if (due >= max_ticks) {
+    // Drop the backlog rather than fall further behind at each frame.
+    accumulator_ = 0;
+    return max_ticks;
+  }
+  int ticks = static_cast<int>(due);
+  accumulator_ -= ticks * step_;
+  return ticks;
+} /* TicksDue() */
+
+void SimulationClock::RecordTicks(int ticks, double seconds) {
+  if (ticks <= 0 || !(seconds > 0)) {
+    return;
+  }
+  double per_tick = seconds / ticks;
+  if (tick_seconds_ > 0) {
+    tick_seconds_ = 0.8 * tick_seconds_ + 0.2 * per_tick;
+  } else {
+    tick_seconds_ = per_tick;
+  }
+} /* RecordTicks() */
+
+NAMESPACE_END(csci3081);
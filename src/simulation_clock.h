@@ -0,0 +1,90 @@
+/**
+ * @file simulation_clock.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_SIMULATION_CLOCK_H_
+#define SRC_SIMULATION_CLOCK_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/common.h"
+#include "src/params.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Decides how many fixed timesteps of the Arena to run each frame.
+ *
+ * Each timestep stands for step seconds of simulated time. The clock
+ * accumulates the wall clock time of the frames, scaled by the multiplier,
+ * and runs one timestep per step accumulated, so the speed of the simulation
+ * no longer depends on the frame rate.
+ *
+ * The timesteps of a frame must fit in the frame budget, or the viewer would
+ * stall: the clock measures how long a timestep takes, and when more are due
+ * than fit in the budget the backlog is dropped, i.e. the simulation runs
+ * slower than requested. In fast forward, every frame runs as many timesteps
+ * as fit in the budget.
+ */
+class SimulationClock {
+ public:
+  explicit SimulationClock(double step = SIMULATION_STEP,
+    double frame_budget = SIMULATION_FRAME_BUDGET);
+
+  /**
+   * @brief The number of timesteps to run for a frame.
+   *
+   * @param dt The wall clock seconds since the previous frame.
+   */
+  int TicksDue(double dt);
+
+  /**
+   * @brief Report that ticks timesteps took seconds to run, to estimate how
+   * many fit in a frame.
+   */
+  void RecordTicks(int ticks, double seconds);
+
+  /**
+   * @brief Forget the time accumulated, e.g. when the simulation is paused.
+   */
+  void Reset() { accumulator_ = 0; }
+
+  /**
+   * @brief The number of timesteps that fit in the frame budget.
+   */
+  int get_max_ticks() const;
+
+  double get_step() const { return step_; }
+  void set_step(double step) { step_ = step; }
+  double get_multiplier() const { return multiplier_; }
+  void set_multiplier(double multiplier) { multiplier_ = multiplier; }
+  bool is_fast_forward() const { return fast_forward_; }
+  void set_fast_forward(bool fast_forward) { fast_forward_ = fast_forward; }
+  double get_frame_budget() const { return frame_budget_; }
+  void set_frame_budget(double budget) { frame_budget_ = budget; }
+
+ private:
+  // simulated seconds per timestep
+  double step_;
+  // wall clock seconds of a frame that may be spent running timesteps
+  double frame_budget_;
+  double multiplier_{1};
+  bool fast_forward_{false};
+  // simulated seconds not yet run
+  double accumulator_{0};
+  // running average of the wall clock seconds per timestep, 0 until measured
+  double tick_seconds_{0};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_SIMULATION_CLOCK_H_
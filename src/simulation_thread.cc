@@ -0,0 +1,133 @@
+/**
+ * @file simulation_thread.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <chrono>
+
+#include "src/simulation_thread.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+SimulationThread::SimulationThread(Arena *arena) : arena_(arena) {
+  arena_->set_draw_tile_size(DRAW_TILE_SIZE);
+  arena_->set_draw_snapshot(&snapshot_);
+}
+
+SimulationThread::~SimulationThread() {
+  Stop();
+  delete arena_;
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void SimulationThread::Start() {
+  if (thread_.joinable()) {
+    return;
+  }
+  stopping_.store(false, std::memory_order_relaxed);
+  thread_ = std::thread(&SimulationThread::Run, this);
+} /* Start() */
+
+void SimulationThread::Stop() {
+  if (!thread_.joinable()) {
+    return;
+  }
+  stopping_.store(true, std::memory_order_release);
+  thread_.join();
+  simulation_command dropped;
+  while (commands_.Pop(&dropped)) {}
+} /* Stop() */
+
+void SimulationThread::Post(const simulation_command &command) {
+  // with no thread running, the caller is the only one using the Arena
+  if (!thread_.joinable()) {
+    Execute(command);
+    return;
+  }
+  while (!commands_.Push(command)) {
+    std::this_thread::yield();
+  }
+} /* Post() */
+
+void SimulationThread::Post(Communication com) {
+  simulation_command command;
+  command.com = com;
+  Post(command);
+} /* Post() */
+
+void SimulationThread::Run() {
+  typedef std::chrono::steady_clock steady_clock;
+  steady_clock::time_point previous = steady_clock::now();
+  simulation_command command;
+  while (!stopping_.load(std::memory_order_acquire)) {
+    while (commands_.Pop(&command)) {
+      Execute(command);
+    }
+
+    steady_clock::time_point now = steady_clock::now();
+    std::chrono::duration<double> dt = now - previous;
+    previous = now;
+    int ticks = clock_.TicksDue(dt.count());
+    if (ticks <= 0) {
+      std::this_thread::sleep_for(
+        std::chrono::duration<double>(SIMULATION_IDLE_SLEEP));
+      continue;
+    }
+    int ran = arena_->AdvanceTime(ticks);
+    std::chrono::duration<double> elapsed = steady_clock::now() - now;
+    clock_.RecordTicks(ran, elapsed.count());
+    if (ran == 0) {
+      // paused, or the game is over
+      std::this_thread::sleep_for(
+        std::chrono::duration<double>(SIMULATION_IDLE_SLEEP));
+    }
+  } /* while(!stopping_..) */
+} /* Run() */
+
+void SimulationThread::Execute(const simulation_command &command) {
+  switch (command.com) {
+    case kNewGame:
+      if (!command.params) {
+        break;
+      }
+      // Rebuilt in place: the Arena keeps its threads, profiling and draw
+      // target, and publishes the new game itself.
+      arena_->Reconfigure(command.params.get());
+      clock_.Reset();
+      break;
+    case kSpeed:
+      clock_.set_multiplier(command.value);
+      break;
+    case kFastForwardOn:
+    case kFastForwardOff:
+      clock_.set_fast_forward(kFastForwardOn == command.com);
+      break;
+    case kProfileOn:
+    case kProfileOff:
+      profiling_ = (kProfileOn == command.com);
+      arena_->set_profiling(profiling_);
+      break;
+    case kPlay:
+    case kPause:
+      clock_.Reset();
+      arena_->AcceptCommand(command.com);
+      break;
+    default:
+      arena_->AcceptCommand(command.com);
+      break;
+  }
+} /* Execute() */
+
+NAMESPACE_END(csci3081);
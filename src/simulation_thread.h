@@ -0,0 +1,117 @@
+/**
+ * @file simulation_thread.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_SIMULATION_THREAD_H_
+#define SRC_SIMULATION_THREAD_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/common.h"
+#include "src/communication.h"
+#include "src/draw_snapshot.h"
+#include "src/params.h"
+#include "src/simulation_clock.h"
+#include "src/spsc_queue.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Struct Definitions
+ ******************************************************************************/
+/**
+ * @brief A command for the simulation thread.
+ */
+struct simulation_command {
+  Communication com{kNone};
+  // the speed multiplier of kSpeed
+  double value{0};
+  // the parameters the Arena is reconfigured with for kNewGame
+  std::shared_ptr<const arena_params> params{};
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Runs an Arena on a thread of its own, at the pace of its own
+ * SimulationClock, so that drawing a frame and running timesteps do not
+ * hold each other up.
+ *
+ * The thread owns the Arena. It takes the commands of one other thread from
+ * a lock-free queue, and publishes a frame to get_snapshot() at the end of
+ * every timestep, for that thread to draw.
+ */
+class SimulationThread {
+ public:
+  /**
+   * @brief Constructor. Takes ownership of arena, which is not run until
+   * Start().
+   */
+  explicit SimulationThread(Arena *arena);
+
+  /**
+   * @brief Destructor. Stops the thread and deletes the Arena.
+   */
+  ~SimulationThread();
+
+  SimulationThread(const SimulationThread &other) = delete;
+  SimulationThread &operator=(const SimulationThread &other) = delete;
+
+  /**
+   * @brief Start running the Arena, paused until a kPlay command.
+   */
+  void Start();
+
+  /**
+   * @brief Stop and join the thread. The commands not yet run are dropped.
+   */
+  void Stop();
+
+  /**
+   * @brief Queue a command for the thread. Waits if the queue is full.
+   * Until Start(), and after Stop(), the command is run right away instead.
+   *
+   * kPlay, kPause, kFoodOn, kFoodOff and the keys go to the Arena;
+   * kNewGame reconfigures it in place; kSpeed, kFastForwardOn and
+   * kFastForwardOff set the clock; kProfileOn and kProfileOff the profiling
+   * of the Arena.
+   */
+  void Post(const simulation_command &command);
+  void Post(Communication com);
+
+  /**
+   * @brief The frames of the Arena, read by the thread posting commands.
+   */
+  DrawSnapshot *get_snapshot() { return &snapshot_; }
+
+  bool is_running() const { return thread_.joinable(); }
+
+ private:
+  void Run();
+  void Execute(const simulation_command &command);
+
+  Arena *arena_;
+  SimulationClock clock_{};
+  bool profiling_{false};
+  DrawSnapshot snapshot_{};
+  SpscQueue<simulation_command, SIMULATION_QUEUE_CAPACITY> commands_{};
+  std::atomic<bool> stopping_{false};
+  std::thread thread_{};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_SIMULATION_THREAD_H_
@@ -0,0 +1,97 @@
+/**
+ * @file spatial_grid.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+
+#include "src/spatial_grid.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+SpatialGrid::SpatialGrid() : cells_(), cell_of_() {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void SpatialGrid::Resize(double x_dim, double y_dim, double cell_size) {
+  cell_size_ = std::max(cell_size, 1.0);
+  cols_ = static_cast<int>(std::ceil(x_dim / cell_size_)) + 1;
+  rows_ = static_cast<int>(std::ceil(y_dim / cell_size_)) + 1;
+  // The cells kept keep their storage, for grids resized again and again
+  cells_.resize(static_cast<size_t>(cols_ * rows_));
+  for (auto &cell : cells_) {
+    cell.clear();
+  }
+  cell_of_.clear();
+}
+
+void SpatialGrid::Clear() {
+  for (auto &cell : cells_) {
+    cell.clear();
+  }
+  cell_of_.clear();
+}
+
+int SpatialGrid::ColumnOf(double x) const {
+  int col = static_cast<int>(std::floor(x / cell_size_));
+  return std::min(std::max(col, 0), cols_ - 1);
+}
+
+int SpatialGrid::RowOf(double y) const {
+  int row = static_cast<int>(std::floor(y / cell_size_));
+  return std::min(std::max(row, 0), rows_ - 1);
+}
+
+void SpatialGrid::Insert(int id, double x, double y) {
+  int cell = RowOf(y) * cols_ + ColumnOf(x);
+  if (static_cast<int>(cell_of_.size()) <= id) {
+    cell_of_.resize(static_cast<size_t>(id) + 1, -1);
+  }
+  cell_of_[id] = cell;
+  cells_[cell].push_back(id);
+}
+
+void SpatialGrid::Move(int id, double x, double y) {
+  int cell = RowOf(y) * cols_ + ColumnOf(x);
+  int old_cell = cell_of_[id];
+  if (cell == old_cell) {
+    return;
+  }
+  std::vector<int> &old_ids = cells_[old_cell];
+  auto it = std::find(old_ids.begin(), old_ids.end(), id);
+  *it = old_ids.back();
+  old_ids.pop_back();
+  cell_of_[id] = cell;
+  cells_[cell].push_back(id);
+}
+
+void SpatialGrid::Query(double x, double y, double range,
+  std::vector<int> *ids) const {
+  ids->clear();
+  int col_min = ColumnOf(x - range);
+  int col_max = ColumnOf(x + range);
+  int row_min = RowOf(y - range);
+  int row_max = RowOf(y + range);
+  for (int row = row_min; row <= row_max; row++) {
+    for (int col = col_min; col <= col_max; col++) {
+      const std::vector<int> &cell = cells_[row * cols_ + col];
+      ids->insert(ids->end(), cell.begin(), cell.end());
+    }
+  }
+  // Callers rely on visiting candidates in the same order as a linear scan.
+  std::sort(ids->begin(), ids->end());
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,95 @@
+/**
+ * @file spatial_grid.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_SPATIAL_GRID_H_
+#define SRC_SPATIAL_GRID_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <vector>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A uniform grid (cell list) over the Arena used as a broadphase.
+ *
+ * Each entry is identified by a small non-negative integer id (usually the
+ * index of the entity in the Arena) and is stored in the cell containing its
+ * center. A query returns every id stored in the cells overlapping a square
+ * around a point, so when the cell size is at least the largest interaction
+ * distance, only the 3x3 block of cells around a point needs to be checked.
+ *
+ * Positions outside of the grid are clamped to the border cells, so entities
+ * that are pushed slightly past a wall are still found.
+ */
+class SpatialGrid {
+ public:
+  /**
+   * @brief Constructor. The grid is empty until Resize() is called.
+   */
+  SpatialGrid();
+
+  /**
+   * @brief Set the covered area and the cell size, and empty the grid.
+   *
+   * @param x_dim The width of the covered area.
+   * @param y_dim The height of the covered area.
+   * @param cell_size The length of a cell side.
+   */
+  void Resize(double x_dim, double y_dim, double cell_size);
+
+  /**
+   * @brief Remove all the entries while keeping the allocated cells.
+   */
+  void Clear();
+
+  /**
+   * @brief Add an entry. Each id can only be inserted once.
+   */
+  void Insert(int id, double x, double y);
+
+  /**
+   * @brief Update the cell of an entry that has moved to (x, y).
+   */
+  void Move(int id, double x, double y);
+
+  /**
+   * @brief Collect the ids stored in the cells overlapping the square of
+   * half-size range centered on (x, y).
+   *
+   * @param[out] ids Cleared, then filled with the ids in ascending order.
+   */
+  void Query(double x, double y, double range, std::vector<int> *ids) const;
+
+  double get_cell_size() const { return cell_size_; }
+  int get_cols() const { return cols_; }
+  int get_rows() const { return rows_; }
+
+ private:
+  int ColumnOf(double x) const;
+  int RowOf(double y) const;
+
+  double cell_size_{1};
+  int cols_{0};
+  int rows_{0};
+  // ids stored in each cell, row-major
+  std::vector<std::vector<int>> cells_;
+  // cell in which each id is stored, -1 if absent
+  std::vector<int> cell_of_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_SPATIAL_GRID_H_
@@ -0,0 +1,87 @@
+/**
+ * @file spsc_queue.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_SPSC_QUEUE_H_
+#define SRC_SPSC_QUEUE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A bounded queue of at most kCapacity values, from one producer
+ * thread to one consumer thread, without locking.
+ *
+ * The producer only writes tail_ and the consumer only writes head_; each
+ * reads the other's index to know whether there is room, or a value. The
+ * indices only grow, and a value sits in the slot of its index modulo
+ * kCapacity.
+ */
+template <class T, size_t kCapacity>
+class SpscQueue {
+  static_assert(kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0,
+                "the capacity of an SpscQueue must be a power of 2");
+
+ public:
+  SpscQueue() : slots_() {}
+
+  SpscQueue(const SpscQueue &other) = delete;
+  SpscQueue &operator=(const SpscQueue &other) = delete;
+
+  /**
+   * @brief Add a value at the back of the queue. Producer only.
+   *
+   * @return false, without adding it, if the queue is full.
+   */
+  bool Push(const T &value) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == kCapacity) {
+      return false;
+    }
+    slots_[tail & (kCapacity - 1)] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Take the value at the front of the queue. Consumer only.
+   *
+   * @return false if the queue is empty.
+   */
+  bool Pop(T *value) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    *value = std::move(slots_[head & (kCapacity - 1)]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  T slots_[kCapacity];
+  // the index of the next value to pop, written by the consumer
+  std::atomic<size_t> head_{0};
+  // the index of the next value to push, written by the producer
+  std::atomic<size_t> tail_{0};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_SPSC_QUEUE_H_
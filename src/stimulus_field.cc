@@ -0,0 +1,164 @@
+/**
+ * @file stimulus_field.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+
+#include "src/stimulus_field.h"
+#include "src/thread_pool.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+// Nodes along a side of a tile
+static const int kTileSize = 16;
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+static bool Moved(double before, double after) {
+  return before < after || before > after;
+}
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+StimulusField::StimulusField()
+  : table_(), values_(4, 0.0), source_x_(), source_y_(), source_radius_(),
+    dirty_(), dirty_tiles_() {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void StimulusField::Resize(double x_dim, double y_dim, double cell_size) {
+  cell_size_ = std::max(cell_size, 0.25);
+  inv_cell_size_ = 1 / cell_size_;
+  cols_ = std::max(static_cast<int>(std::ceil(x_dim / cell_size_)) + 1, 2);
+  rows_ = std::max(static_cast<int>(std::ceil(y_dim / cell_size_)) + 1, 2);
+  tile_cols_ = (cols_ + kTileSize - 1) / kTileSize;
+  tile_rows_ = (rows_ + kTileSize - 1) / kTileSize;
+  values_.assign(static_cast<size_t>(cols_ * rows_), 0.0);
+  dirty_.assign(static_cast<size_t>(tile_cols_ * tile_rows_), 0);
+  dirty_tiles_.clear();
+  up_to_date_ = false;
+} /* Resize() */
+
+void StimulusField::set_response(double sensitivity, double cutoff) {
+  table_.Build(sensitivity, cutoff);
+  cutoff_ = cutoff;
+  up_to_date_ = false;
+} /* set_response() */
+
+int StimulusField::FirstNode(double v, double reach, int count) const {
+  double node = std::floor((v - reach) * inv_cell_size_);
+  return static_cast<int>(std::min(std::max(node, 0.0),
+    static_cast<double>(count - 1)));
+} /* FirstNode() */
+
+int StimulusField::LastNode(double v, double reach, int count) const {
+  double node = std::ceil((v + reach) * inv_cell_size_);
+  return static_cast<int>(std::min(std::max(node, 0.0),
+    static_cast<double>(count - 1)));
+} /* LastNode() */
+
+void StimulusField::MarkTiles(double x, double y, double radius) {
+  double reach = radius + cutoff_;
+  int first_col = FirstNode(x, reach, cols_) / kTileSize;
+  int last_col = LastNode(x, reach, cols_) / kTileSize;
+  int first_row = FirstNode(y, reach, rows_) / kTileSize;
+  int last_row = LastNode(y, reach, rows_) / kTileSize;
+  for (int row = first_row; row <= last_row; row++) {
+    for (int col = first_col; col <= last_col; col++) {
+      int tile = row * tile_cols_ + col;
+      if (!dirty_[tile]) {
+        dirty_[tile] = 1;
+        dirty_tiles_.push_back(tile);
+      }
+    }
+  }
+} /* MarkTiles() */
+
+void StimulusField::Update(size_t n_sources, const double *source_x,
+  const double *source_y, const double *source_radius, ThreadPool *pool) {
+  if (!up_to_date_ || n_sources != source_x_.size()) {
+    dirty_tiles_.clear();
+    for (int tile = 0; tile < tile_cols_ * tile_rows_; tile++) {
+      dirty_[tile] = 1;
+      dirty_tiles_.push_back(tile);
+    }
+  } else {
+    for (size_t j = 0; j < n_sources; j++) {
+      if (Moved(source_x_[j], source_x[j]) ||
+          Moved(source_y_[j], source_y[j]) ||
+          Moved(source_radius_[j], source_radius[j])) {
+        MarkTiles(source_x_[j], source_y_[j], source_radius_[j]);
+        MarkTiles(source_x[j], source_y[j], source_radius[j]);
+      }
+    }
+  }
+  source_x_.assign(source_x, source_x + n_sources);
+  source_y_.assign(source_y, source_y + n_sources);
+  source_radius_.assign(source_radius, source_radius + n_sources);
+  up_to_date_ = true;
+
+  n_rasterized_tiles_ = dirty_tiles_.size();
+  auto rasterize = [this](size_t begin, size_t end, size_t) {
+    for (size_t k = begin; k < end; k++) {
+      RasterizeTile(dirty_tiles_[k]);
+    }
+  };
+  if (pool) {
+    pool->ParallelFor(0, dirty_tiles_.size(), rasterize);
+  } else {
+    rasterize(0, dirty_tiles_.size(), 0);
+  }
+  for (int tile : dirty_tiles_) {
+    dirty_[tile] = 0;
+  }
+  dirty_tiles_.clear();
+} /* Update() */
+
+void StimulusField::RasterizeTile(int tile) {
+  int tile_col = (tile % tile_cols_) * kTileSize;
+  int tile_row = (tile / tile_cols_) * kTileSize;
+  int end_col = std::min(tile_col + kTileSize, cols_);
+  int end_row = std::min(tile_row + kTileSize, rows_);
+  for (int row = tile_row; row < end_row; row++) {
+    std::fill(&values_[row * cols_ + tile_col], &values_[row * cols_ + end_col],
+      0.0);
+  }
+  for (size_t j = 0; j < source_x_.size(); j++) {
+    double reach = source_radius_[j] + cutoff_;
+    int first_col = std::max(FirstNode(source_x_[j], reach, cols_), tile_col);
+    int last_col = std::min(LastNode(source_x_[j], reach, cols_), end_col - 1);
+    int first_row = std::max(FirstNode(source_y_[j], reach, rows_), tile_row);
+    int last_row = std::min(LastNode(source_y_[j], reach, rows_), end_row - 1);
+    for (int row = first_row; row <= last_row; row++) {
+      double delta_y = row * cell_size_ - source_y_[j];
+      double *values = &values_[row * cols_];
+      for (int col = first_col; col <= last_col; col++) {
+        double delta_x = col * cell_size_ - source_x_[j];
+        double distance = std::sqrt(delta_x * delta_x + delta_y * delta_y) -
+          source_radius_[j];
+        //  Too far away to make a noticeable difference
+        if (distance > cutoff_) {
+          continue;
+        }
+        values[col] += table_.Response(std::max(distance, 0.0));
+      }
+    }
+  }
+} /* RasterizeTile() */
+
+NAMESPACE_END(csci3081);
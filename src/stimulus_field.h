@@ -0,0 +1,137 @@
+/**
+ * @file stimulus_field.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_STIMULUS_FIELD_H_
+#define SRC_STIMULUS_FIELD_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <vector>
+
+#include "src/common.h"
+#include "src/response_table.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+class ThreadPool;
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief The sum of the responses to a set of sources (lights or food),
+ * SENSOR_GAIN / sensitivity^distance, rasterised on a regular grid over the
+ * Arena and bilinearly interpolated in between.
+ *
+ * Sampling the field costs the same whatever the number of sources, so a
+ * very large number of sensors can read it instead of visiting every source.
+ *
+ * The responses at the nodes are read from a ResponseTable, so they are
+ * within a relative RESPONSE_TABLE_TOLERANCE of the exact ones.
+ *
+ * Sources further than the cutoff from a node do not contribute to it. The
+ * grid is split in square tiles, and Update() only rasterises again the
+ * tiles that a moved source covered or now covers. Every node of a tile is
+ * summed over the sources in order, so a field brought up to date gives
+ * exactly the same values as one rasterised from scratch.
+ */
+class StimulusField {
+ public:
+  /**
+   * @brief Constructor. The field is 0 until Resize() and Update() are
+   * called.
+   */
+  StimulusField();
+
+  /**
+   * @brief Set the covered area and the distance between the grid nodes.
+   * The whole field is rasterised at the next Update().
+   *
+   * @param x_dim The width of the covered area.
+   * @param y_dim The height of the covered area.
+   * @param cell_size The distance between two neighbouring nodes.
+   */
+  void Resize(double x_dim, double y_dim, double cell_size);
+
+  /**
+   * @brief Set the sensitivity of the response, and the distance beyond
+   * which a source is ignored. The whole field is rasterised at the next
+   * Update().
+   */
+  void set_response(double sensitivity, double cutoff);
+
+  /**
+   * @brief Bring the field up to date with the given sources, rasterising
+   * again the tiles covered by the sources that moved since the last update.
+   *
+   * @param pool Splits the tiles among its threads, if not nullptr.
+   */
+  void Update(size_t n_sources, const double *source_x,
+    const double *source_y, const double *source_radius, ThreadPool *pool);
+
+  /**
+   * @brief The field at a point, clamped to the covered area.
+   */
+  double Sample(double x, double y) const {
+    double fx = std::min(std::max(x * inv_cell_size_, 0.0),
+      static_cast<double>(cols_ - 1));
+    double fy = std::min(std::max(y * inv_cell_size_, 0.0),
+      static_cast<double>(rows_ - 1));
+    int col = std::min(static_cast<int>(fx), cols_ - 2);
+    int row = std::min(static_cast<int>(fy), rows_ - 2);
+    double tx = fx - col;
+    double ty = fy - row;
+    const double *node = &values_[static_cast<size_t>(row * cols_ + col)];
+    double bottom = node[0] + tx * (node[1] - node[0]);
+    double top = node[cols_] + tx * (node[cols_ + 1] - node[cols_]);
+    return bottom + ty * (top - bottom);
+  }
+
+  double get_cell_size() const { return cell_size_; }
+  int get_cols() const { return cols_; }
+  int get_rows() const { return rows_; }
+  /**
+   * @brief The number of tiles rasterised by the last Update().
+   */
+  size_t get_n_rasterized_tiles() const { return n_rasterized_tiles_; }
+
+ private:
+  // The first or last node within distance reach of v, clamped to the grid
+  int FirstNode(double v, double reach, int count) const;
+  int LastNode(double v, double reach, int count) const;
+  void MarkTiles(double x, double y, double radius);
+  void RasterizeTile(int tile);
+
+  double cell_size_{1};
+  double inv_cell_size_{1};
+  // Nodes per row and per column
+  int cols_{2};
+  int rows_{2};
+  int tile_cols_{1};
+  int tile_rows_{1};
+  ResponseTable table_;
+  double cutoff_{0};
+  // Field at each node, row-major
+  std::vector<double> values_;
+  // The sources as of the last Update()
+  std::vector<double> source_x_;
+  std::vector<double> source_y_;
+  std::vector<double> source_radius_;
+  bool up_to_date_{false};
+  // Tiles to rasterise at the next Update()
+  std::vector<char> dirty_;
+  std::vector<int> dirty_tiles_;
+  size_t n_rasterized_tiles_{0};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_STIMULUS_FIELD_H_
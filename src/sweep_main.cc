@@ -0,0 +1,196 @@
+/**
+ * @file sweep_main.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "src/arena_params.h"
+#include "src/batch_runner.h"
+#include "src/parameter_sweep.h"
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+static void PrintUsage(const char *program) {
+  std::cerr << "Usage: " << program << " [options]\n"
+    << "Runs every combination of the listed values, each replicate with its "
+    << "own seed,\non all cores, and prints the results as they finish.\n"
+    << "  --robots N,N,...        number of robots\n"
+    << "  --lights N,N,...        number of lights\n"
+    << "  --food N,N,...          number of food\n"
+    << "  --ratio N,N,...         percentage of fearful robots\n"
+    << "  --sensitivity N,N,...   light sensitivity of the robots\n"
+    << "  --food-on 0|1,...       whether robots need food\n"
+    << "  --list FILE             run the parameter sets of FILE instead, one\n"
+    << "                          per line: robots,lights,food,ratio,"
+    << "sensitivity,food_on\n"
+    << "  --replicates N          runs of each parameter set (default 1)\n"
+    << "  --ticks N               timesteps per run (default 10000)\n"
+    << "  --workers N             threads (default: all cores)\n"
+    << "  --seed N                base seed (default 1)\n"
+    << "  --format csv|json       output format, json is JSON Lines\n"
+    << "  --output FILE           write to FILE instead of the standard "
+    << "output\n";
+}
+
+static bool ParseCount(const std::string &text, size_t *value) {
+  char *end = nullptr;
+  int64_t parsed = std::strtoll(text.c_str(), &end, 10);
+  if (text.empty() || *end != '\0' || parsed < 0) {
+    return false;
+  }
+  *value = static_cast<size_t>(parsed);
+  return true;
+}
+
+static bool ParseList(const std::string &text, std::vector<size_t> *values) {
+  values->clear();
+  std::istringstream in(text);
+  std::string item;
+  while (std::getline(in, item, ',')) {
+    size_t value = 0;
+    if (!ParseCount(item, &value)) {
+      return false;
+    }
+    values->push_back(value);
+  }
+  return !values->empty();
+}
+
+int main(int argc, char **argv) {
+  csci3081::sweep_grid grid;
+  csci3081::arena_params base;
+  std::string list_file;
+  std::string output_file;
+  csci3081::SweepWriter::Format format = csci3081::SweepWriter::kCsv;
+  size_t replicates = 1;
+  size_t ticks = 10000;
+  size_t workers = std::thread::hardware_concurrency();
+  size_t seed = 1;
+
+  for (int i = 1; i < argc; i++) {
+    std::string option = argv[i];
+    if (option == "--help") {
+      PrintUsage(argv[0]);
+      return 0;
+    }
+    if (i + 1 >= argc) {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+    std::string value = argv[++i];
+    std::vector<size_t> values;
+    bool ok = true;
+    if (option == "--list") {
+      list_file = value;
+    } else if (option == "--output") {
+      output_file = value;
+    } else if (option == "--format") {
+      if (value == "csv") {
+        format = csci3081::SweepWriter::kCsv;
+      } else if (value == "json") {
+        format = csci3081::SweepWriter::kJson;
+      } else {
+        ok = false;
+      }
+    } else if (option == "--replicates") {
+      ok = ParseCount(value, &replicates) && replicates > 0;
+    } else if (option == "--ticks") {
+      ok = ParseCount(value, &ticks);
+    } else if (option == "--workers") {
+      ok = ParseCount(value, &workers);
+    } else if (option == "--seed") {
+      ok = ParseCount(value, &seed);
+    } else if (!ParseList(value, &values)) {
+      ok = false;
+    } else if (option == "--robots") {
+      grid.n_robots = values;
+    } else if (option == "--lights") {
+      grid.n_lights = values;
+    } else if (option == "--food") {
+      grid.n_food = values;
+    } else if (option == "--ratio") {
+      grid.n_ratio = values;
+    } else if (option == "--sensitivity") {
+      grid.n_light_sensitivity = values;
+    } else if (option == "--food-on") {
+      grid.food_on.clear();
+      for (size_t on : values) {
+        grid.food_on.push_back(on != 0);
+      }
+    } else {
+      ok = false;
+    }
+    if (!ok) {
+      std::cerr << "Invalid option " << option << " " << value << "\n";
+      PrintUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  csci3081::ParameterSweep sweep;
+  if (list_file.empty()) {
+    sweep.AddGrid(grid, base);
+  } else {
+    std::ifstream list(list_file);
+    if (!list) {
+      std::cerr << "Cannot read " << list_file << "\n";
+      return 1;
+    }
+    std::string line;
+    while (std::getline(list, line)) {
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+      std::vector<size_t> values;
+      if (!ParseList(line, &values) || values.size() != 6) {
+        std::cerr << "Invalid parameter set: " << line << "\n";
+        return 1;
+      }
+      csci3081::arena_params params = base;
+      params.n_robots = values[0];
+      params.n_lights = values[1];
+      params.n_food = values[2];
+      params.n_ratio = values[3];
+      params.n_light_sensitivity = values[4];
+      params.food_on = (values[5] != 0);
+      sweep.AddParams(params);
+    }
+  }
+
+  for (const auto &params : sweep.get_sets()) {
+    std::string error = csci3081::BatchRunner::CheckParams(params);
+    if (!error.empty()) {
+      std::cerr << "Invalid parameters: " << error << "\n";
+      return 1;
+    }
+  }
+
+  std::ofstream output;
+  if (!output_file.empty()) {
+    output.open(output_file);
+    if (!output) {
+      std::cerr << "Cannot write " << output_file << "\n";
+      return 1;
+    }
+  }
+  csci3081::SweepWriter writer(output_file.empty() ? &std::cout : &output,
+    format);
+  sweep.set_replicates(static_cast<int>(replicates));
+  sweep.set_max_ticks(static_cast<int>(ticks));
+  sweep.set_base_seed(static_cast<uint32_t>(seed));
+  sweep.Run(workers, &writer);
+  return 0;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file thread_pool.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/thread_pool.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+ThreadPool::ThreadPool(size_t n_threads)
+    : workers_(), mutex_(), start_(), done_() {
+  for (size_t chunk = 1; chunk < n_threads; chunk++) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this, chunk);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  start_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void ThreadPool::ParallelFor(size_t begin, size_t end, const Body &body) {
+  if (end <= begin) {
+    return;
+  }
+  if (workers_.empty()) {
+    body(begin, end, 0);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    body_ = &body;
+    begin_ = begin;
+    end_ = end;
+    pending_ = workers_.size();
+    generation_++;
+  }
+  start_.notify_all();
+
+  RunChunk(0);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this] { return pending_ == 0; });
+  body_ = nullptr;
+}
+
+void ThreadPool::RunChunk(size_t chunk) {
+  size_t n = get_n_threads();
+  size_t length = end_ - begin_;
+  size_t chunk_begin = begin_ + length * chunk / n;
+  size_t chunk_end = begin_ + length * (chunk + 1) / n;
+  if (chunk_begin < chunk_end) {
+    (*body_)(chunk_begin, chunk_end, chunk);
+  }
+}
+
+void ThreadPool::WorkerLoop(size_t chunk) {
+  size_t seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_.wait(lock, [this, seen] {
+        return stopping_ || generation_ != seen;
+      });
+      if (stopping_) {
+        return;
+      }
+      seen = generation_;
+    }
+
+    RunChunk(chunk);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--pending_ == 0) {
+      done_.notify_one();
+    }
+  }
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,96 @@
+/**
+ * @file thread_pool.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_THREAD_POOL_H_
+#define SRC_THREAD_POOL_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A fixed set of worker threads running data-parallel loops.
+ *
+ * ParallelFor() splits a range of indices into one contiguous chunk per
+ * thread. The calling thread runs the first chunk itself, and the call
+ * returns once every chunk is done. The split only depends on the range and
+ * the number of threads, so each index is always handled the same way.
+ *
+ * A pool of one thread starts no worker and runs every loop inline.
+ */
+class ThreadPool {
+ public:
+  /**
+   * @brief The body of a loop, run on the indices [begin, end). chunk is in
+   * [0, get_n_threads()) and is unique among the chunks running at the same
+   * time, so it can select per-thread scratch data.
+   */
+  typedef std::function<void(size_t begin, size_t end, size_t chunk)> Body;
+
+  /**
+   * @brief Constructor.
+   *
+   * @param n_threads The number of threads running each loop, including the
+   * calling thread. 0 is treated as 1.
+   */
+  explicit ThreadPool(size_t n_threads);
+
+  /**
+   * @brief Destructor. Stops and joins the worker threads.
+   */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool& other) = delete;
+  ThreadPool& operator=(const ThreadPool& other) = delete;
+
+  /**
+   * @brief Run body over [begin, end) split among the threads, and wait for
+   * it to complete. Must not be called from within a body.
+   */
+  void ParallelFor(size_t begin, size_t end, const Body &body);
+
+  size_t get_n_threads() const { return workers_.size() + 1; }
+
+ private:
+  void WorkerLoop(size_t chunk);
+  void RunChunk(size_t chunk);
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  // Signals the workers that a new loop is available, or that they must stop
+  std::condition_variable start_;
+  // Signals the calling thread that the last worker chunk is done
+  std::condition_variable done_;
+
+  // The loop being run
+  const Body *body_{nullptr};
+  size_t begin_{0};
+  size_t end_{0};
+  // Incremented for every loop, so the workers know when a new one starts
+  size_t generation_{0};
+  // Worker chunks of the current loop not done yet
+  size_t pending_{0};
+  bool stopping_{false};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_THREAD_POOL_H_
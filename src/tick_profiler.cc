@@ -0,0 +1,142 @@
+/**
+ * @file tick_profiler.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <iomanip>
+
+#include "src/tick_profiler.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Static Member Functions
+ ******************************************************************************/
+bool TickProfiler::is_available() {
+#ifdef ARENA_PROFILING
+  return true;
+#else
+  return false;
+#endif
+}
+
+const char *TickProfiler::PhaseName(TickPhase phase) {
+  switch (phase) {
+    case kPhaseLights: return "lights";
+    case kPhaseSense: return "sense";
+    case kPhaseControl: return "control";
+    case kPhaseIntegrate: return "integrate";
+    case kPhaseWalls: return "walls";
+    case kPhaseOverlaps: return "overlaps";
+    case kPhasePublish: return "publish";
+    default: return "unknown";
+  }
+}
+
+const char *TickProfiler::CounterName(TickCounter counter) {
+  switch (counter) {
+    case kCountPairsTested: return "pairs tested";
+    case kCountCollisions: return "collisions";
+    case kCountWallCollisions: return "wall collisions";
+    case kCountResponses: return "pow calls";
+    case kCountReverseArcs: return "reverse arcs";
+    case kCountFieldTiles: return "field tiles";
+    default: return "unknown";
+  }
+}
+
+void TickProfiler::Write(std::ostream &out, const tick_stats &stats) {
+  double ticks = (stats.ticks > 0) ? static_cast<double>(stats.ticks) : 1;
+  out << std::fixed << std::setprecision(1)
+      << "tick " << 1e6 * stats.seconds / ticks << " us over "
+      << stats.ticks << " ticks\n";
+  for (int p = 0; p < kPhaseCount; p++) {
+    out << "  " << std::setw(16) << std::left
+        << PhaseName(static_cast<TickPhase>(p)) << std::right
+        << std::setw(10) << 1e6 * stats.phase_seconds[p] / ticks << " us\n";
+  }
+  for (int c = 0; c < kCounterCount; c++) {
+    out << "  " << std::setw(16) << std::left
+        << CounterName(static_cast<TickCounter>(c)) << std::right
+        << std::setw(10) << static_cast<double>(stats.counts[c]) / ticks
+        << "\n";
+  }
+  out << std::defaultfloat;
+} /* Write() */
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void TickProfiler::BeginTick() {
+  if (!enabled_) {
+    return;
+  }
+  current_ = tick_stats();
+  tick_start_ = Clock::now();
+  phase_start_ = tick_start_;
+  phase_ = kPhaseLights;
+  in_tick_ = true;
+} /* BeginTick() */
+
+void TickProfiler::EnterPhase(TickPhase phase) {
+  if (!in_tick_) {
+    return;
+  }
+  Clock::time_point now = Clock::now();
+  current_.phase_seconds[phase_] +=
+    std::chrono::duration<double>(now - phase_start_).count();
+  phase_start_ = now;
+  phase_ = phase;
+} /* EnterPhase() */
+
+void TickProfiler::EndTick() {
+  if (!in_tick_) {
+    return;
+  }
+  Clock::time_point now = Clock::now();
+  current_.phase_seconds[phase_] +=
+    std::chrono::duration<double>(now - phase_start_).count();
+  current_.seconds = std::chrono::duration<double>(now - tick_start_).count();
+  current_.ticks = 1;
+  in_tick_ = false;
+
+  last_ = current_;
+  totals_.ticks++;
+  totals_.seconds += current_.seconds;
+  for (int p = 0; p < kPhaseCount; p++) {
+    totals_.phase_seconds[p] += current_.phase_seconds[p];
+  }
+  for (int c = 0; c < kCounterCount; c++) {
+    totals_.counts[c] += current_.counts[c];
+  }
+
+  if (log_ && log_interval_ > 0 &&
+      totals_.ticks - logged_.ticks >= log_interval_) {
+    tick_stats interval;
+    interval.ticks = totals_.ticks - logged_.ticks;
+    interval.seconds = totals_.seconds - logged_.seconds;
+    for (int p = 0; p < kPhaseCount; p++) {
+      interval.phase_seconds[p] =
+        totals_.phase_seconds[p] - logged_.phase_seconds[p];
+    }
+    for (int c = 0; c < kCounterCount; c++) {
+      interval.counts[c] = totals_.counts[c] - logged_.counts[c];
+    }
+    Write(*log_, interval);
+    logged_ = totals_;
+  }
+} /* EndTick() */
+
+void TickProfiler::Reset() {
+  totals_ = tick_stats();
+  logged_ = tick_stats();
+} /* Reset() */
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,177 @@
+/**
+ * @file tick_profiler.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_TICK_PROFILER_H_
+#define SRC_TICK_PROFILER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/*
+ * The instrumentation of the timestep is only compiled in when
+ * ARENA_PROFILING is defined (e.g. `make PROFILING=1`). Otherwise these
+ * macros expand to nothing, and the profiler only reports zeros.
+ */
+#ifdef ARENA_PROFILING
+#define PROFILE_TICK_BEGIN(profiler) (profiler).BeginTick()
+#define PROFILE_PHASE(profiler, phase) (profiler).EnterPhase(phase)
+#define PROFILE_TICK_END(profiler) (profiler).EndTick()
+// A statement only run when profiling, e.g. to count in a local counter
+#define PROFILE_ONLY(statement) statement
+#else
+#define PROFILE_TICK_BEGIN(profiler)
+#define PROFILE_PHASE(profiler, phase)
+#define PROFILE_TICK_END(profiler)
+#define PROFILE_ONLY(statement)
+#endif
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Type Definitions
+ ******************************************************************************/
+/**
+ * @brief The phases of Arena::UpdateEntitiesTimestep(), in order.
+ */
+enum TickPhase {
+  kPhaseLights,       // lights pick their velocity
+  kPhaseSense,        // sensor readings, including the sensing grids
+  kPhaseControl,      // robot controllers pick their velocity
+  kPhaseIntegrate,    // robots and lights move
+  kPhaseWalls,        // wall collisions
+  kPhaseOverlaps,     // entity collisions, including the collision grid
+  kPhasePublish,      // draw snapshot and trajectory recording
+  kPhaseCount
+};
+
+/**
+ * @brief What the profiler counts during a timestep.
+ */
+enum TickCounter {
+  kCountPairsTested,      // entity pairs tested for overlap
+  kCountCollisions,       // overlaps resolved
+  kCountWallCollisions,   // entities pushed off a wall
+  kCountResponses,        // sensor responses SENSOR_GAIN / s^d (pow calls)
+  kCountReverseArcs,      // robots doing a reverse arc
+  kCountFieldTiles,       // stimulus field tiles rasterised
+  kCounterCount
+};
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief Time spent in each phase and counts, over some number of ticks.
+ */
+struct tick_stats {
+  uint64_t ticks{0};
+  double seconds{0};
+  double phase_seconds[kPhaseCount]{};
+  uint64_t counts[kCounterCount]{};
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Times the phases of the Arena timestep and accumulates its counters.
+ *
+ * The timestep marks the start of each phase, and the time since the
+ * previous mark is charged to the previous phase, so a tick only reads the
+ * clock once per phase. Counters are summed by the Arena from per-thread
+ * counts at the end of the parallel phases, so Count() is only called by the
+ * thread running the timestep.
+ *
+ * Nothing is measured while the profiler is disabled, which is the default.
+ * When enabled with a log interval, the average of every interval is
+ * written to the log stream.
+ */
+class TickProfiler {
+ public:
+  TickProfiler() = default;
+  TickProfiler(const TickProfiler& other) = delete;
+  TickProfiler& operator=(const TickProfiler& other) = delete;
+
+  /**
+   * @brief Whether the instrumentation is compiled in (ARENA_PROFILING).
+   */
+  static bool is_available();
+
+  static const char *PhaseName(TickPhase phase);
+  static const char *CounterName(TickCounter counter);
+
+  void set_enabled(bool enabled) { enabled_ = enabled; }
+  bool is_enabled() const { return enabled_; }
+
+  /**
+   * @brief Write the averages to log every interval ticks, 0 to never log.
+   */
+  void set_log(std::ostream *log, uint64_t interval) {
+    log_ = log;
+    log_interval_ = interval;
+  }
+
+  void BeginTick();
+  void EnterPhase(TickPhase phase);
+  void EndTick();
+  void Count(TickCounter counter, uint64_t n) {
+    if (in_tick_) {
+      current_.counts[counter] += n;
+    }
+  }
+
+  /**
+   * @brief The last complete tick.
+   */
+  const tick_stats &get_last_tick() const { return last_; }
+
+  /**
+   * @brief Every tick since the profiler was created or reset.
+   */
+  const tick_stats &get_totals() const { return totals_; }
+
+  /**
+   * @brief Forget the totals.
+   */
+  void Reset();
+
+  /**
+   * @brief Write stats, averaged per tick, one phase or counter per line.
+   */
+  static void Write(std::ostream &out, const tick_stats &stats);
+
+ private:
+  typedef std::chrono::steady_clock Clock;
+
+  bool enabled_{false};
+  bool in_tick_{false};
+  TickPhase phase_{kPhaseLights};
+  Clock::time_point tick_start_{};
+  Clock::time_point phase_start_{};
+  tick_stats current_{};
+  tick_stats last_{};
+  tick_stats totals_{};
+  // totals_ at the previous log
+  tick_stats logged_{};
+  std::ostream *log_{nullptr};
+  uint64_t log_interval_{0};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_TICK_PROFILER_H_
@@ -0,0 +1,204 @@
+/**
+ * @file trajectory_reader.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+
+#include "src/trajectory_reader.h"
+#include "src/binary_io.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+TrajectoryReader::~TrajectoryReader() {
+  Close();
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+bool TrajectoryReader::Open(const std::string &path) {
+  Close();
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+    close(fd);
+    return false;
+  }
+  size_ = static_cast<size_t>(info.st_size);
+  void *data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid once the file is closed
+  close(fd);
+  if (data == MAP_FAILED) {
+    size_ = 0;
+    return false;
+  }
+  data_ = static_cast<char *>(data);
+  if (!ReadHeader()) {
+    Close();
+    return false;
+  }
+  return true;
+} /* Open() */
+
+void TrajectoryReader::Close() {
+  if (data_) {
+    munmap(data_, size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  n_robots_ = 0;
+  chunk_ticks_ = 0;
+  n_ticks_ = 0;
+  radius_.clear();
+  type_.clear();
+  chunk_offsets_.clear();
+  chunk_rows_.clear();
+  has_decoded_ = false;
+} /* Close() */
+
+bool TrajectoryReader::ReadHeader() {
+  const char *cursor = data_;
+  const char *end = data_ + size_;
+  char magic[sizeof(TRAJECTORY_MAGIC)];
+  uint32_t version = 0;
+  uint64_t n_chunks = 0;
+  uint64_t index_offset = 0;
+  if (!ReadValue(&cursor, end, &magic) ||
+      std::memcmp(magic, TRAJECTORY_MAGIC, sizeof(magic)) != 0 ||
+      !ReadValue(&cursor, end, &version) || version != TRAJECTORY_VERSION ||
+      !ReadValue(&cursor, end, &n_robots_) ||
+      !ReadValue(&cursor, end, &chunk_ticks_) || chunk_ticks_ == 0 ||
+      !ReadValue(&cursor, end, &n_ticks_) ||
+      !ReadValue(&cursor, end, &n_chunks) ||
+      !ReadValue(&cursor, end, &index_offset)) {
+    return false;
+  }
+  // A recording that was not closed still has an index_offset of 0
+  if (index_offset == 0 ||
+      n_chunks != (n_ticks_ + chunk_ticks_ - 1) / chunk_ticks_ ||
+      index_offset > size_ || (size_ - index_offset) / 8 < n_chunks) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < n_robots_; i++) {
+    float radius = 0;
+    uint32_t type = 0;
+    if (!ReadValue(&cursor, end, &radius) ||
+        !ReadValue(&cursor, end, &type)) {
+      return false;
+    }
+    radius_.push_back(radius);
+    type_.push_back(static_cast<RobotType>(type));
+  }
+
+  cursor = data_ + index_offset;
+  for (uint64_t c = 0; c < n_chunks; c++) {
+    uint64_t offset = 0;
+    ReadValue(&cursor, end, &offset);
+    const char *chunk = data_ + std::min<uint64_t>(offset, size_);
+    uint64_t first_tick = 0;
+    uint32_t rows = 0;
+    if (!ReadValue(&chunk, end, &first_tick) ||
+        !ReadValue(&chunk, end, &rows) ||
+        first_tick != c * chunk_ticks_ ||
+        rows != std::min<uint64_t>(chunk_ticks_, n_ticks_ - first_tick)) {
+      return false;
+    }
+    uint64_t bytes = TRAJECTORY_CHUNK_HEADER_SIZE +
+      uint64_t{sizeof(float)} * kColumnCount * rows * n_robots_;
+    if (offset + bytes > size_) {
+      return false;
+    }
+    chunk_offsets_.push_back(offset);
+    chunk_rows_.push_back(rows);
+  }
+  return true;
+} /* ReadHeader() */
+
+const char *TrajectoryReader::ColumnRow(size_t chunk, int column,
+                                        uint32_t row) const {
+  uint64_t values = static_cast<uint64_t>(column) * chunk_rows_[chunk] +
+    row;
+  return data_ + chunk_offsets_[chunk] + TRAJECTORY_CHUNK_HEADER_SIZE +
+    sizeof(float) * values * n_robots_;
+} /* ColumnRow() */
+
+bool TrajectoryReader::ReadTick(uint64_t tick,
+                                std::vector<trajectory_sample> *samples) {
+  if (!data_ || tick >= n_ticks_) {
+    return false;
+  }
+  size_t chunk = static_cast<size_t>(tick / chunk_ticks_);
+  uint32_t row = static_cast<uint32_t>(tick % chunk_ticks_);
+  const char *end = data_ + size_;
+
+  // Continue from the tick last read if it is earlier in the same chunk,
+  // otherwise start from the poses at the start of the chunk
+  uint32_t next = 0;
+  if (has_decoded_ && decoded_tick_ <= tick &&
+      decoded_tick_ / chunk_ticks_ == chunk) {
+    next = static_cast<uint32_t>(decoded_tick_ % chunk_ticks_) + 1;
+  } else {
+    x_.assign(n_robots_, 0);
+    y_.assign(n_robots_, 0);
+    theta_.assign(n_robots_, 0);
+  }
+  for (; next <= row; next++) {
+    const char *x = ColumnRow(chunk, kColumnX, next);
+    const char *y = ColumnRow(chunk, kColumnY, next);
+    const char *theta = ColumnRow(chunk, kColumnTheta, next);
+    for (size_t i = 0; i < n_robots_; i++) {
+      float delta_x = 0, delta_y = 0, delta_theta = 0;
+      ReadValue(&x, end, &delta_x);
+      ReadValue(&y, end, &delta_y);
+      ReadValue(&theta, end, &delta_theta);
+      // Row 0 holds the poses themselves, and the poses start from 0
+      x_[i] += delta_x;
+      y_[i] += delta_y;
+      theta_[i] += delta_theta;
+    }
+  }
+  decoded_tick_ = tick;
+  has_decoded_ = true;
+
+  samples->resize(n_robots_);
+  const char *columns[kColumnCount];
+  for (int c = 0; c < kColumnCount; c++) {
+    columns[c] = ColumnRow(chunk, c, row);
+  }
+  for (size_t i = 0; i < n_robots_; i++) {
+    trajectory_sample &sample = (*samples)[i];
+    sample.x = x_[i];
+    sample.y = y_[i];
+    sample.theta = theta_[i];
+    ReadValue(&columns[kColumnVelLeft], end, &sample.vel_left);
+    ReadValue(&columns[kColumnVelRight], end, &sample.vel_right);
+    ReadValue(&columns[kColumnLightLeft], end, &sample.light_left);
+    ReadValue(&columns[kColumnLightRight], end, &sample.light_right);
+    ReadValue(&columns[kColumnFoodLeft], end, &sample.food_left);
+    ReadValue(&columns[kColumnFoodRight], end, &sample.food_right);
+    ReadValue(&columns[kColumnHunger], end, &sample.hunger);
+  }
+  return true;
+} /* ReadTick() */
+
+NAMESPACE_END(csci3081);
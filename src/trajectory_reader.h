@@ -0,0 +1,103 @@
+/**
+ * @file trajectory_reader.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_TRAJECTORY_READER_H_
+#define SRC_TRAJECTORY_READER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/common.h"
+#include "src/robot_type.h"
+#include "src/trajectory_recorder.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Reads back the ticks of a file written by TrajectoryRecorder.
+ *
+ * The file is memory-mapped, so only the chunks that are read are loaded
+ * from disk. The index gives the chunk of any tick directly; within the
+ * chunk, at most TRAJECTORY_CHUNK_TICKS pose deltas are added up. Reading
+ * the ticks in order only adds one delta per tick.
+ */
+class TrajectoryReader {
+ public:
+  TrajectoryReader() = default;
+  ~TrajectoryReader();
+
+  TrajectoryReader(const TrajectoryReader& other) = delete;
+  TrajectoryReader& operator=(const TrajectoryReader& other) = delete;
+
+  /**
+   * @brief Map the trajectory file at path.
+   *
+   * @return false if the file cannot be read or is not a complete
+   * trajectory file.
+   */
+  bool Open(const std::string &path);
+
+  void Close();
+
+  bool is_open() const { return data_ != nullptr; }
+  size_t get_n_robots() const { return n_robots_; }
+  uint64_t get_n_ticks() const { return n_ticks_; }
+  uint32_t get_chunk_ticks() const { return chunk_ticks_; }
+  double get_radius(size_t robot) const { return radius_[robot]; }
+  RobotType get_robot_type(size_t robot) const { return type_[robot]; }
+
+  /**
+   * @brief Read the state of every robot at a tick.
+   *
+   * @param tick The tick, from 0 to get_n_ticks() - 1.
+   * @param[out] samples Resized to get_n_robots().
+   *
+   * @return false if there is no such tick.
+   */
+  bool ReadTick(uint64_t tick, std::vector<trajectory_sample> *samples);
+
+ private:
+  /**
+   * @brief The value of column for the first robot at row of chunk.
+   */
+  const char *ColumnRow(size_t chunk, int column, uint32_t row) const;
+
+  /**
+   * @brief Check the header, robot table and index of the mapped file.
+   */
+  bool ReadHeader();
+
+  char *data_{nullptr};
+  size_t size_{0};
+  uint32_t n_robots_{0};
+  uint32_t chunk_ticks_{0};
+  uint64_t n_ticks_{0};
+  std::vector<double> radius_{};
+  std::vector<RobotType> type_{};
+  std::vector<uint64_t> chunk_offsets_{};
+  std::vector<uint32_t> chunk_rows_{};
+
+  // The poses decoded for the tick last read, to continue from there
+  uint64_t decoded_tick_{0};
+  bool has_decoded_{false};
+  std::vector<float> x_{};
+  std::vector<float> y_{};
+  std::vector<float> theta_{};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_TRAJECTORY_READER_H_
@@ -0,0 +1,153 @@
+/**
+ * @file trajectory_recorder.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/trajectory_recorder.h"
+#include "src/binary_io.h"
+#include "src/robot.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+TrajectoryRecorder::TrajectoryRecorder(uint32_t chunk_ticks)
+  : chunk_ticks_((chunk_ticks > 0) ? chunk_ticks : 1) {}
+
+TrajectoryRecorder::~TrajectoryRecorder() {
+  Close();
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+bool TrajectoryRecorder::Open(const std::string &path) {
+  Close();
+  out_.open(path, std::ios::binary | std::ios::trunc);
+  n_robots_ = 0;
+  started_ = false;
+  n_ticks_ = 0;
+  chunk_rows_ = 0;
+  chunk_offsets_.clear();
+  return out_.is_open();
+} /* Open() */
+
+bool TrajectoryRecorder::Record(const EntityStore &store,
+                                const std::vector<Robot *> &robots) {
+  if (!out_.is_open()) {
+    return false;
+  }
+  if (!started_) {
+    // The header is rewritten by Close(), once the # of ticks is known
+    n_robots_ = static_cast<uint32_t>(store.n_robots);
+    WriteHeader(0);
+    for (size_t i = 0; i < store.n_robots; i++) {
+      WriteValue(out_, static_cast<float>(store.radius[i]));
+      WriteValue(out_, static_cast<uint32_t>(robots[i]->get_robot_type()));
+    }
+    size_t n = static_cast<size_t>(chunk_ticks_) * n_robots_;
+    columns_.assign((kColumnCount - 1) * n, 0);
+    hunger_.assign(n, 0);
+    last_x_.assign(n_robots_, 0);
+    last_y_.assign(n_robots_, 0);
+    last_theta_.assign(n_robots_, 0);
+    started_ = true;
+  }
+  if (store.n_robots != n_robots_) {
+    return false;
+  }
+
+  size_t row = static_cast<size_t>(chunk_rows_) * n_robots_;
+  float *x = column(kColumnX) + row;
+  float *y = column(kColumnY) + row;
+  float *theta = column(kColumnTheta) + row;
+  // The position of a robot at the end of the timestep is the one after the
+  // collisions were resolved
+  for (size_t i = 0; i < n_robots_; i++) {
+    if (chunk_rows_ == 0) {
+      // The first tick of a chunk holds the poses themselves
+      x[i] = static_cast<float>(store.resolved_x[i]);
+      y[i] = static_cast<float>(store.resolved_y[i]);
+      theta[i] = static_cast<float>(store.theta[i]);
+      last_x_[i] = x[i];
+      last_y_[i] = y[i];
+      last_theta_[i] = theta[i];
+    } else {
+      x[i] = static_cast<float>(store.resolved_x[i] - last_x_[i]);
+      y[i] = static_cast<float>(store.resolved_y[i] - last_y_[i]);
+      theta[i] = static_cast<float>(store.theta[i] - last_theta_[i]);
+      last_x_[i] += x[i];
+      last_y_[i] += y[i];
+      last_theta_[i] += theta[i];
+    }
+    column(kColumnVelLeft)[row + i] = static_cast<float>(store.vel_left[i]);
+    column(kColumnVelRight)[row + i] = static_cast<float>(store.vel_right[i]);
+    column(kColumnLightLeft)[row + i] =
+      static_cast<float>(store.light_left[i]);
+    column(kColumnLightRight)[row + i] =
+      static_cast<float>(store.light_right[i]);
+    column(kColumnFoodLeft)[row + i] = static_cast<float>(store.food_left[i]);
+    column(kColumnFoodRight)[row + i] =
+      static_cast<float>(store.food_right[i]);
+    hunger_[row + i] = robots[i]->get_hungry_counter();
+  }
+
+  n_ticks_++;
+  if (++chunk_rows_ == chunk_ticks_) {
+    WriteChunk();
+  }
+  return true;
+} /* Record() */
+
+bool TrajectoryRecorder::Close() {
+  if (!out_.is_open()) {
+    return false;
+  }
+  if (!started_) {
+    WriteHeader(0);
+    started_ = true;
+  }
+  if (chunk_rows_ > 0) {
+    WriteChunk();
+  }
+  uint64_t index_offset = static_cast<uint64_t>(out_.tellp());
+  WriteValues(out_, chunk_offsets_.data(), chunk_offsets_.size());
+  out_.seekp(0);
+  WriteHeader(index_offset);
+  bool ok = static_cast<bool>(out_);
+  out_.close();
+  return ok;
+} /* Close() */
+
+void TrajectoryRecorder::WriteHeader(uint64_t index_offset) {
+  out_.write(TRAJECTORY_MAGIC, sizeof(TRAJECTORY_MAGIC));
+  WriteValue(out_, TRAJECTORY_VERSION);
+  WriteValue(out_, n_robots_);
+  WriteValue(out_, chunk_ticks_);
+  WriteValue(out_, n_ticks_);
+  WriteValue(out_, static_cast<uint64_t>(chunk_offsets_.size()));
+  WriteValue(out_, index_offset);
+} /* WriteHeader() */
+
+void TrajectoryRecorder::WriteChunk() {
+  chunk_offsets_.push_back(static_cast<uint64_t>(out_.tellp()));
+  WriteValue(out_, n_ticks_ - chunk_rows_);
+  WriteValue(out_, chunk_rows_);
+  WriteValue(out_, static_cast<uint32_t>(0));
+  size_t n = static_cast<size_t>(chunk_rows_) * n_robots_;
+  for (int c = 0; c < kColumnHunger; c++) {
+    WriteValues(out_, column(c), n);
+  }
+  WriteValues(out_, hunger_.data(), n);
+  chunk_rows_ = 0;
+} /* WriteChunk() */
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,171 @@
+/**
+ * @file trajectory_recorder.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_TRAJECTORY_RECORDER_H_
+#define SRC_TRAJECTORY_RECORDER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "src/common.h"
+#include "src/entity_store.h"
+#include "src/params.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+/*
+ * Layout of a trajectory file, in the byte order of the machine:
+ *
+ *   header   "BVTR", version, # robots, ticks per chunk, # ticks,
+ *            # chunks, offset of the index
+ *   robots   radius (float) and RobotType of each robot
+ *   chunks   first tick, # ticks, then one column per TrajectoryColumn,
+ *            each holding the value of every robot for every tick of the
+ *            chunk, tick by tick
+ *   index    offset of each chunk
+ *
+ * The pose columns hold the pose at the first tick of the chunk, then the
+ * change since the previous tick, so a chunk can be decoded on its own.
+ */
+const char TRAJECTORY_MAGIC[4] = {'B', 'V', 'T', 'R'};
+const uint32_t TRAJECTORY_VERSION = 1;
+const size_t TRAJECTORY_CHUNK_HEADER_SIZE = 16;
+
+/**
+ * @brief The columns of a chunk, in order. All are float32 but the hunger.
+ */
+enum TrajectoryColumn {
+  kColumnX,            // delta encoded
+  kColumnY,            // delta encoded
+  kColumnTheta,        // delta encoded
+  kColumnVelLeft,
+  kColumnVelRight,
+  kColumnLightLeft,
+  kColumnLightRight,
+  kColumnFoodLeft,
+  kColumnFoodRight,
+  kColumnHunger,       // int32
+  kColumnCount
+};
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief The recorded state of one robot at one tick.
+ */
+struct trajectory_sample {
+  float x{0};
+  float y{0};
+  float theta{0};
+  float vel_left{0};
+  float vel_right{0};
+  float light_left{0};
+  float light_right{0};
+  float food_left{0};
+  float food_right{0};
+  int32_t hunger{0};
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+class Robot;
+
+/**
+ * @brief Writes the pose, wheel velocities, sensor readings and hunger of
+ * every robot at every tick to a trajectory file, which TrajectoryReader
+ * reads back.
+ *
+ * The ticks are buffered in memory and written a chunk at a time. The index
+ * and the final header are written by Close(), so a file is only readable
+ * once the recorder is closed.
+ *
+ * Poses are stored as float32. Each delta is taken from the pose as the
+ * reader will decode it, not from the exact previous pose, so the rounding
+ * errors do not add up along a chunk.
+ */
+class TrajectoryRecorder {
+ public:
+  /**
+   * @param chunk_ticks The # of ticks per chunk.
+   */
+  explicit TrajectoryRecorder(uint32_t chunk_ticks = TRAJECTORY_CHUNK_TICKS);
+  ~TrajectoryRecorder();
+
+  TrajectoryRecorder(const TrajectoryRecorder& other) = delete;
+  TrajectoryRecorder& operator=(const TrajectoryRecorder& other) = delete;
+
+  /**
+   * @brief Start a new recording in the file at path.
+   *
+   * @return false if the file cannot be written.
+   */
+  bool Open(const std::string &path);
+
+  /**
+   * @brief Record one tick. The # of robots is set by the first tick.
+   *
+   * @param store The entity store of the Arena, after the timestep.
+   * @param robots The robots of the Arena, in the order of store.
+   *
+   * @return false if the recorder is not open or the # of robots changed.
+   */
+  bool Record(const EntityStore &store, const std::vector<Robot *> &robots);
+
+  /**
+   * @brief Write the last chunk and the index, and close the file.
+   *
+   * @return false if any write failed.
+   */
+  bool Close();
+
+  bool is_open() const { return out_.is_open(); }
+  uint64_t get_n_ticks() const { return n_ticks_; }
+
+ private:
+  /**
+   * @brief Write the header at the current position. It is first written
+   * with an index_offset of 0, and again by Close() once the file is done.
+   */
+  void WriteHeader(uint64_t index_offset);
+  void WriteChunk();
+
+  float *column(int column) {
+    return &columns_[static_cast<size_t>(column) * chunk_ticks_ * n_robots_];
+  }
+
+  std::ofstream out_{};
+  uint32_t chunk_ticks_;
+  uint32_t n_robots_{0};
+  bool started_{false};
+  uint64_t n_ticks_{0};
+  // # of ticks in the chunk being buffered
+  uint32_t chunk_rows_{0};
+  // Float columns of the chunk being buffered, and its hunger column
+  std::vector<float> columns_{};
+  std::vector<int32_t> hunger_{};
+  // The poses of the previous tick, as the reader decodes them
+  std::vector<float> last_x_{};
+  std::vector<float> last_y_{};
+  std::vector<float> last_theta_{};
+  std::vector<uint64_t> chunk_offsets_{};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_TRAJECTORY_RECORDER_H_
@@ -0,0 +1,177 @@
+/**
+ * @file wiring.cc
+ *
+ * @copyright 2018 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <sstream>
+
+#include "src/wiring.h"
+#include "src/simd.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+// The policies' 10 * (reading / 1000)
+static const double kReadingGain = 0.01;
+
+static const char *const kBehaviorNames[kBehaviorCount] = {
+  "fear", "explorer"
+};
+static const char *const kBandNames[kHungerBandCount] = {
+  "sated", "hungry", "starving"
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/* The wiring of a policy from its sated (light) and starving (food) wirings,
+ * mixed by the policy's shares when hungry.
+ */
+template <class Policy>
+static vehicle_wiring MixWiring(const wiring_matrix &light,
+  const wiring_matrix &food) {
+  vehicle_wiring wiring;
+  wiring.band[kSated] = light;
+  wiring.band[kStarving] = food;
+  for (size_t w = 0; w < kWiringWeightCount; w++) {
+    wiring.band[kHungry].weight[w] =
+      Policy::kHungryLightShare * light.weight[w] +
+      Policy::kHungryFoodShare * food.weight[w];
+  }
+  return wiring;
+}
+
+vehicle_wiring DefaultWiring(RobotType behavior) {
+  const double g = kReadingGain;
+  // Crossed food sensors, as in AggressiveFoodPolicy
+  const wiring_matrix food = {{0, 0, 0, g, 0, 0, 0, g, 0, 0}};
+  if (kExplorer == behavior) {
+    // Crossed light sensors, inhibiting
+    const wiring_matrix light = {{0, -g, 0, 0, 10, -g, 0, 0, 0, 10}};
+    return MixWiring<ExplorePolicy>(light, food);
+  }
+  // Uncrossed light sensors, exciting
+  const wiring_matrix light = {{g, 0, 0, 0, 0, 0, g, 0, 0, 0}};
+  return MixWiring<FearPolicy>(light, food);
+} /* DefaultWiring() */
+
+wiring_table DefaultWirings() {
+  wiring_table wirings;
+  for (size_t b = 0; b < kBehaviorCount; b++) {
+    wirings[b] = DefaultWiring(static_cast<RobotType>(b));
+  }
+  return wirings;
+} /* DefaultWirings() */
+
+/* The index of name in names, or -1 */
+static int FindName(const std::string &name, const char *const *names,
+  int n_names) {
+  for (int i = 0; i < n_names; i++) {
+    if (name == names[i]) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+bool ReadWirings(std::istream &in, wiring_table *wirings,
+  std::string *error) {
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream fields(line);
+    std::string behavior_name, band_name, wheel;
+    if (!(fields >> behavior_name) || '#' == behavior_name[0]) {
+      continue;
+    }
+    int behavior = FindName(behavior_name, kBehaviorNames, kBehaviorCount);
+    int band = -1;
+    if (fields >> band_name) {
+      band = FindName(band_name, kBandNames, kHungerBandCount);
+    }
+    fields >> wheel;
+    double weight[kWiringInputCount];
+    for (int k = 0; k < kWiringInputCount; k++) {
+      fields >> weight[k];
+    }
+    std::string extra;
+    if (behavior < 0 || band < 0 || (wheel != "left" && wheel != "right") ||
+        fields.fail() || (fields >> extra)) {
+      *error = line;
+      return false;
+    }
+    double *row = (*wirings)[behavior].band[band].weight +
+      ((wheel == "left") ? 0 : kWiringInputCount);
+    std::copy(weight, weight + kWiringInputCount, row);
+  }
+  return true;
+} /* ReadWirings() */
+
+/* The wheel velocities of kLanes robots, whose weights are stride apart */
+static void ApplyBlock(size_t stride, const double *weights,
+  const double *light_left, const double *light_right,
+  const double *food_left, const double *food_right, const double *max_speed,
+  double *vel_left, double *vel_right) {
+  const Vec input[kWiringInputCount] = {Load(light_left), Load(light_right),
+    Load(food_left), Load(food_right), Set1(1)};
+  const double *right_weights = weights + kWiringInputCount * stride;
+  Vec left = Mul(Load(weights), input[0]);
+  Vec right = Mul(Load(right_weights), input[0]);
+  for (size_t k = 1; k < kWiringInputCount; k++) {
+    left = Add(left, Mul(Load(weights + k * stride), input[k]));
+    right = Add(right, Mul(Load(right_weights + k * stride), input[k]));
+  }
+  // Keep the speeds within [-max_speed, max_speed]
+  Vec limit = Load(max_speed);
+  Vec neg_limit = Xor(limit, Set1(-0.0));
+  Store(vel_left, Min(Max(left, neg_limit), limit));
+  Store(vel_right, Min(Max(right, neg_limit), limit));
+}
+
+void ApplyWirings(size_t n, const double *weights, const double *light_left,
+  const double *light_right, const double *food_left,
+  const double *food_right, const double *max_speed, double *vel_left,
+  double *vel_right) {
+  size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    ApplyBlock(n, weights + i, light_left + i, light_right + i,
+      food_left + i, food_right + i, max_speed + i, vel_left + i,
+      vel_right + i);
+  }
+  if (i == n) {
+    return;
+  }
+
+  // The last, padded block (see simd.h)
+  double w[kWiringWeightCount * kLanes] = {0};
+  double in[kWiringInputCount - 1][kLanes] = {{0}};
+  double limit[kLanes] = {0};
+  double left[kLanes] = {0};
+  double right[kLanes] = {0};
+  size_t n_left = n - i;
+  for (size_t k = 0; k < n_left; k++) {
+    for (size_t j = 0; j < kWiringWeightCount; j++) {
+      w[j * kLanes + k] = weights[j * n + i + k];
+    }
+    in[kWireLightLeft][k] = light_left[i + k];
+    in[kWireLightRight][k] = light_right[i + k];
+    in[kWireFoodLeft][k] = food_left[i + k];
+    in[kWireFoodRight][k] = food_right[i + k];
+    limit[k] = max_speed[i + k];
+  }
+  ApplyBlock(kLanes, w, in[kWireLightLeft], in[kWireLightRight],
+    in[kWireFoodLeft], in[kWireFoodRight], limit, left, right);
+  std::copy(left, left + n_left, vel_left + i);
+  std::copy(right, right + n_left, vel_right + i);
+}
+
+NAMESPACE_END(csci3081);
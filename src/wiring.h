@@ -0,0 +1,132 @@
+/**
+ * @file wiring.h
+ *
+ * @copyright 2018 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_WIRING_H_
+#define SRC_WIRING_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <array>
+#include <cstddef>
+#include <istream>
+#include <string>
+
+#include "src/common.h"
+#include "src/robot_policy.h"
+#include "src/robot_type.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Type Definitions
+ ******************************************************************************/
+/**
+ * @brief The inputs of a wiring matrix, in order.
+ */
+enum WiringInput {
+  kWireLightLeft,
+  kWireLightRight,
+  kWireFoodLeft,
+  kWireFoodRight,
+  kWireBias,          // always 1
+  kWiringInputCount
+};
+
+/**
+ * @brief The # of weights of a wiring matrix: a row of inputs per wheel.
+ */
+const size_t kWiringWeightCount = 2 * kWiringInputCount;
+
+/**
+ * @brief The wiring of a Braitenberg vehicle: each wheel speed is the
+ * weighted sum of the sensor readings and a bias, clamped to the maximum
+ * speed.
+ *
+ * Weights [0, kWiringInputCount) drive the left wheel, the others the right
+ * wheel.
+ */
+struct wiring_matrix {
+  double weight[kWiringWeightCount]{};
+};
+
+/**
+ * @brief The wiring of one behaviour in each hunger band.
+ */
+struct vehicle_wiring {
+  wiring_matrix band[kHungerBandCount]{};
+};
+
+/**
+ * @brief The wiring of every behaviour, indexed by RobotType.
+ */
+typedef std::array<vehicle_wiring, kBehaviorCount> wiring_table;
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief The wiring equivalent to the policy of a behaviour: FearPolicy
+ * for kFear and ExplorePolicy for kExplorer.
+ *
+ * As no sensor reading exceeds MAX_READING, the light and food speeds of
+ * the policies never exceed ROBOT_MAX_SPEED, so only the final clamp is
+ * ever active. For robots of ROBOT_MAX_SPEED the wiring then gives the same
+ * wheel velocities as the policy, up to rounding.
+ */
+vehicle_wiring DefaultWiring(RobotType behavior);
+
+/**
+ * @brief The default wiring of every behaviour.
+ */
+wiring_table DefaultWirings();
+
+/**
+ * @brief Change wirings according to a text configuration.
+ *
+ * Each line sets the weights of one wheel of one behaviour in one hunger
+ * band, the wirings not listed being left unchanged:
+ *
+ *   # behaviour band     wheel light_left light_right food_left food_right bias
+ *   explorer    sated    left  0          -0.01       0         0          10
+ *
+ * with fear or explorer, sated, hungry or starving, and left or right.
+ * Blank lines and lines starting with # are skipped.
+ *
+ * @param[out] error The line at fault, when false is returned.
+ *
+ * @return false if a line cannot be parsed.
+ */
+bool ReadWirings(std::istream &in, wiring_table *wirings, std::string *error);
+
+/**
+ * @brief Compute the wheel velocities of many robots, each with its own
+ * wiring matrix.
+ *
+ * This is a small matrix-vector product per robot, evaluated several robots
+ * at a time (see simd.h).
+ *
+ * @param n The number of robots.
+ * @param weights Weight w of robot i at weights[w * n + i].
+ * @param light_left The left light sensor reading of each robot.
+ * @param light_right The right light sensor reading of each robot.
+ * @param food_left The left food sensor reading of each robot.
+ * @param food_right The right food sensor reading of each robot.
+ * @param max_speed The maximum speed of each robot.
+ * @param[out] vel_left The left wheel velocity of each robot.
+ * @param[out] vel_right The right wheel velocity of each robot.
+ */
+void ApplyWirings(size_t n, const double *weights, const double *light_left,
+  const double *light_right, const double *food_left,
+  const double *food_right, const double *max_speed, double *vel_left,
+  double *vel_right);
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_WIRING_H_
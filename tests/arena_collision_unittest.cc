@@ -0,0 +1,162 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <vector>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/collision_mode.h"
+#include "src/entity_type.h"
+#include "src/spatial_grid.h"
+#include "src/params.h"
+
+#ifdef ARENA_COLLISION_TESTS
+
+/******************************************************
+* TEST FEATURE SetUp
+*******************************************************/
+class ArenaCollisionTest : public ::testing::Test {
+
+protected:
+  virtual void SetUp() {
+    // Two arenas with the same entities, one for each collision mode
+    params.n_robots = N_ROBOTS;
+    params.n_lights = N_LIGHTS;
+    params.n_food = 4;
+    params.collision_mode = csci3081::kCollisionBruteForce;
+    brute_arena = new csci3081::Arena(&params);
+    params.collision_mode = csci3081::kCollisionGrid;
+    grid_arena = new csci3081::Arena(&params);
+  }
+
+  virtual void TearDown() {
+    delete brute_arena;
+    delete grid_arena;
+  }
+
+  // Crowd the mobile entities of the brute force arena in a small area and
+  // copy every pose and radius over to the grid arena.
+  void CrowdAndCopy() {
+    std::vector<csci3081::ArenaEntity *> from = brute_arena->get_entities();
+    std::vector<csci3081::ArenaEntity *> to = grid_arena->get_entities();
+    for (size_t i = 0; i < from.size(); i++) {
+      if (from[i]->get_type() != csci3081::kFood) {
+        from[i]->set_position(300 + (i % 5) * 25, 300 + (i / 5) * 25);
+      }
+      to[i]->set_pose(from[i]->get_pose());
+      to[i]->set_radius(from[i]->get_radius());
+    }
+  }
+
+  csci3081::arena_params params;
+  csci3081::Arena * brute_arena;
+  csci3081::Arena * grid_arena;
+};
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+TEST_F(ArenaCollisionTest, GridQueryFindsNeighbours) {
+  csci3081::SpatialGrid grid;
+  std::vector<int> ids;
+  grid.Resize(1000, 800, 100);
+  grid.Insert(0, 50, 50);
+  grid.Insert(1, 140, 60);
+  grid.Insert(2, 500, 500);
+  grid.Insert(3, -20, 900);
+
+  grid.Query(60, 60, 100, &ids);
+  EXPECT_EQ(ids, std::vector<int>({0, 1}))
+    << "\nFAIL neighbours of (60,60) should be 0 and 1";
+
+  // out of bound entries are clamped to the border cells
+  grid.Query(10, 790, 100, &ids);
+  EXPECT_EQ(ids, std::vector<int>({3}))
+    << "\nFAIL out of bound entry should be in the corner cell";
+
+  grid.Move(2, 70, 40);
+  grid.Query(60, 60, 100, &ids);
+  EXPECT_EQ(ids, std::vector<int>({0, 1, 2}))
+    << "\nFAIL moved entry should be found in its new cell";
+}
+
+TEST_F(ArenaCollisionTest, GridMatchesBruteForce) {
+  CrowdAndCopy();
+  std::vector<csci3081::ArenaEntity *> brute = brute_arena->get_entities();
+  std::vector<csci3081::ArenaEntity *> grid = grid_arena->get_entities();
+
+  for (int t = 0; t < 500; t++) {
+    brute_arena->UpdateEntitiesTimestep();
+    grid_arena->UpdateEntitiesTimestep();
+    for (size_t i = 0; i < brute.size(); i++) {
+      ASSERT_EQ(brute[i]->get_pose().x, grid[i]->get_pose().x)
+        << "\nFAIL x differs for entity " << i << " at timestep " << t;
+      ASSERT_EQ(brute[i]->get_pose().y, grid[i]->get_pose().y)
+        << "\nFAIL y differs for entity " << i << " at timestep " << t;
+      ASSERT_EQ(brute[i]->get_pose().theta, grid[i]->get_pose().theta)
+        << "\nFAIL heading differs for entity " << i << " at timestep " << t;
+    }
+  }
+}
+
+TEST_F(ArenaCollisionTest, ThreadCountDoesNotChangeResult) {
+  // Run the same crowded arena on 1 and 4 threads, in every sensing mode
+  for (csci3081::SensingMode mode : {csci3081::kSenseAll,
+      csci3081::kSenseCutoff, csci3081::kSenseField}) {
+    params.collision_mode = csci3081::kCollisionGrid;
+    params.sensing_mode = mode;
+    params.n_threads = 1;
+    csci3081::Arena single_arena(&params);
+    params.n_threads = 4;
+    csci3081::Arena threaded_arena(&params);
+    EXPECT_EQ(threaded_arena.get_n_threads(), 4u);
+
+    std::vector<csci3081::ArenaEntity *> single = single_arena.get_entities();
+    std::vector<csci3081::ArenaEntity *> threaded =
+      threaded_arena.get_entities();
+    for (size_t i = 0; i < single.size(); i++) {
+      if (single[i]->get_type() != csci3081::kFood) {
+        single[i]->set_position(300 + (i % 5) * 25, 300 + (i / 5) * 25);
+      }
+      threaded[i]->set_pose(single[i]->get_pose());
+      threaded[i]->set_radius(single[i]->get_radius());
+    }
+
+    for (int t = 0; t < 300; t++) {
+      single_arena.UpdateEntitiesTimestep();
+      threaded_arena.UpdateEntitiesTimestep();
+      for (size_t i = 0; i < single.size(); i++) {
+        ASSERT_EQ(single[i]->get_pose().x, threaded[i]->get_pose().x)
+          << "\nFAIL x differs for entity " << i << " at timestep " << t;
+        ASSERT_EQ(single[i]->get_pose().y, threaded[i]->get_pose().y)
+          << "\nFAIL y differs for entity " << i << " at timestep " << t;
+        ASSERT_EQ(single[i]->get_pose().theta, threaded[i]->get_pose().theta)
+          << "\nFAIL heading differs for entity " << i << " at timestep " << t;
+      }
+    }
+  }
+}
+
+#ifdef ARENA_PROFILING
+TEST_F(ArenaCollisionTest, ProfilerCountsPairsTested) {
+  brute_arena->set_profiling(true);
+  brute_arena->UpdateEntitiesTimestep();
+  const csci3081::tick_stats &stats = brute_arena->get_tick_stats();
+  // Every robot and light is tested against every other entity
+  size_t n_entities = params.n_robots + params.n_lights + params.n_food;
+  EXPECT_EQ(stats.ticks, 1u);
+  EXPECT_EQ(stats.counts[csci3081::kCountPairsTested],
+    (params.n_robots + params.n_lights) * (n_entities - 1));
+  // Each sensor evaluates every light and food
+  EXPECT_EQ(stats.counts[csci3081::kCountResponses],
+    2 * params.n_robots * (params.n_lights + params.n_food));
+  EXPECT_GT(stats.seconds, 0);
+
+  brute_arena->set_profiling(false);
+  brute_arena->UpdateEntitiesTimestep();
+  EXPECT_EQ(brute_arena->get_profiler()->get_totals().ticks, 1u)
+    << "\nFAIL nothing should be measured while profiling is off";
+}
+#endif /* ARENA_PROFILING */
+
+#endif /* ARENA_COLLISION_TESTS */
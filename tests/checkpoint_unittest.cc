@@ -0,0 +1,159 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+#include "src/arena.h"
+#include "src/arena_params.h"
+
+#ifdef CHECKPOINT_TESTS
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+static void ExpectSameEntities(const csci3081::Arena &expected,
+                               const csci3081::Arena &actual) {
+  std::vector<csci3081::ArenaEntity *> a = expected.get_entities();
+  std::vector<csci3081::ArenaEntity *> b = actual.get_entities();
+  ASSERT_EQ(a.size(), b.size());
+  for (size_t i = 0; i < a.size(); i++) {
+    EXPECT_EQ(a[i]->get_pose().x, b[i]->get_pose().x) << "entity " << i;
+    EXPECT_EQ(a[i]->get_pose().y, b[i]->get_pose().y) << "entity " << i;
+    EXPECT_EQ(a[i]->get_pose().theta, b[i]->get_pose().theta);
+    EXPECT_EQ(a[i]->get_radius(), b[i]->get_radius());
+    if (a[i]->get_type() == csci3081::kRobot) {
+      auto *robot_a = static_cast<csci3081::Robot *>(a[i]);
+      auto *robot_b = static_cast<csci3081::Robot *>(b[i]);
+      EXPECT_EQ(robot_a->get_hungry_counter(), robot_b->get_hungry_counter());
+      EXPECT_EQ(robot_a->is_reverse_arcing(), robot_b->is_reverse_arcing());
+    }
+  }
+  EXPECT_EQ(expected.get_game_status(), actual.get_game_status());
+}
+
+TEST(CheckpointTest, RestoredArenaContinuesIdentically) {
+  csci3081::arena_params params;
+  params.n_robots = 30;
+  params.n_lights = 6;
+  params.n_food = 5;
+  params.seed = 11;
+  csci3081::Arena saved(&params);
+  for (int t = 0; t < 400; t++) {
+    saved.UpdateEntitiesTimestep();
+  }
+  std::stringstream checkpoint;
+  ASSERT_TRUE(saved.SaveCheckpoint(checkpoint));
+
+  csci3081::arena_params restored_params;
+  restored_params.n_threads = 2;
+  ASSERT_TRUE(csci3081::Arena::ReadCheckpointParams(checkpoint,
+                                                    &restored_params));
+  EXPECT_EQ(restored_params.n_robots, 30u);
+  EXPECT_EQ(restored_params.seed, 11u);
+  EXPECT_EQ(restored_params.n_threads, 2u);
+  csci3081::Arena restored(&restored_params);
+  checkpoint.seekg(0);
+  ASSERT_TRUE(restored.RestoreCheckpoint(checkpoint));
+  ExpectSameEntities(saved, restored);
+
+  for (int t = 0; t < 400; t++) {
+    saved.UpdateEntitiesTimestep();
+    restored.UpdateEntitiesTimestep();
+  }
+  ExpectSameEntities(saved, restored);
+
+  // The random streams are restored too, so resets place entities alike
+  saved.Reset();
+  restored.Reset();
+  ExpectSameEntities(saved, restored);
+}
+
+TEST(CheckpointTest, ReconfiguredArenaMatchesANewOne) {
+  csci3081::arena_params params;
+  params.n_robots = 30;
+  params.n_lights = 6;
+  params.n_food = 5;
+  params.seed = 11;
+  csci3081::Arena reused(&params);
+  for (int t = 0; t < 300; t++) {
+    reused.UpdateEntitiesTimestep();
+  }
+
+  // More entities, in another sensing mode, then fewer, in a smaller arena
+  csci3081::arena_params grown = params;
+  grown.n_robots = 60;
+  grown.n_food = 9;
+  grown.seed = 12;
+  grown.sensing_mode = csci3081::kSenseField;
+  csci3081::arena_params shrunk = params;
+  shrunk.n_robots = 4;
+  shrunk.n_lights = 2;
+  shrunk.x_dim = 700;
+  shrunk.y_dim = 600;
+  shrunk.seed = 13;
+  shrunk.sensing_mode = csci3081::kSenseCutoff;
+  shrunk.food_sensing_threshold = 4;
+  for (const csci3081::arena_params &next : {grown, shrunk}) {
+    reused.Reconfigure(&next);
+    csci3081::Arena fresh(&next);
+    ExpectSameEntities(fresh, reused);
+    for (int t = 0; t < 300; t++) {
+      fresh.UpdateEntitiesTimestep();
+      reused.UpdateEntitiesTimestep();
+    }
+    ExpectSameEntities(fresh, reused);
+  }
+}
+
+TEST(CheckpointTest, KeptFoodReadingsAreRestored) {
+  csci3081::arena_params params;
+  params.n_robots = 30;
+  params.n_food = 12;
+  params.seed = 7;
+  params.food_sensing_threshold = 4;
+  csci3081::Arena saved(&params);
+  for (int t = 0; t < 250; t++) {
+    saved.UpdateEntitiesTimestep();
+  }
+  std::stringstream checkpoint;
+  ASSERT_TRUE(saved.SaveCheckpoint(checkpoint));
+
+  csci3081::arena_params restored_params;
+  ASSERT_TRUE(csci3081::Arena::ReadCheckpointParams(checkpoint,
+                                                    &restored_params));
+  EXPECT_EQ(restored_params.food_sensing_threshold, 4);
+  csci3081::Arena restored(&restored_params);
+  checkpoint.seekg(0);
+  ASSERT_TRUE(restored.RestoreCheckpoint(checkpoint));
+
+  // Readings kept before the checkpoint are reused after it in both arenas
+  for (int t = 0; t < 250; t++) {
+    saved.UpdateEntitiesTimestep();
+    restored.UpdateEntitiesTimestep();
+  }
+  ExpectSameEntities(saved, restored);
+}
+
+TEST(CheckpointTest, CheckpointOfAnotherArenaIsRejected) {
+  csci3081::arena_params params;
+  params.seed = 11;
+  csci3081::Arena saved(&params);
+  std::stringstream checkpoint;
+  ASSERT_TRUE(saved.SaveCheckpoint(checkpoint));
+
+  params.n_robots = 3;
+  csci3081::Arena other(&params);
+  EXPECT_FALSE(other.RestoreCheckpoint(checkpoint))
+    << "\nFAIL the arenas do not have the same entities";
+
+  std::stringstream truncated(checkpoint.str().substr(0, 200));
+  csci3081::Arena same(&saved.get_params());
+  EXPECT_FALSE(same.RestoreCheckpoint(truncated));
+
+  std::stringstream garbage("not a checkpoint");
+  csci3081::arena_params read;
+  EXPECT_FALSE(csci3081::Arena::ReadCheckpointParams(garbage, &read));
+}
+
+#endif /* CHECKPOINT_TESTS */
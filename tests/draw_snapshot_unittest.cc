@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/draw_snapshot.h"
+
+#ifdef DRAW_SNAPSHOT_TESTS
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+TEST(DrawSnapshotTest, FramesMatchEntitiesAfterEachTimestep) {
+  csci3081::arena_params params;
+  params.n_robots = 12;
+  params.seed = 3;
+  csci3081::Arena arena(&params);
+  csci3081::DrawSnapshot &snapshot = arena.get_draw_snapshot();
+  EXPECT_EQ(snapshot.get_sequence(), 1u);
+
+  for (int t = 0; t < 3; t++) {
+    arena.UpdateEntitiesTimestep();
+    ASSERT_TRUE(snapshot.Acquire());
+    const csci3081::draw_frame &frame = snapshot.get_front();
+    EXPECT_EQ(frame.game_status, arena.get_game_status());
+
+    const std::vector<csci3081::ArenaEntity *> &entities =
+      arena.get_entities();
+    ASSERT_EQ(frame.records.size(), entities.size());
+    for (size_t i = 0; i < entities.size(); i++) {
+      const csci3081::draw_record &record = frame.records[i];
+      EXPECT_FLOAT_EQ(record.x, entities[i]->get_pose().x);
+      EXPECT_FLOAT_EQ(record.y, entities[i]->get_pose().y);
+      EXPECT_FLOAT_EQ(record.theta, entities[i]->get_pose().theta);
+      EXPECT_FLOAT_EQ(record.radius, entities[i]->get_radius());
+      EXPECT_EQ(record.type, entities[i]->get_type());
+      EXPECT_EQ(record.r, entities[i]->get_color().r);
+      EXPECT_EQ(std::string(frame.get_label(record.label)),
+        entities[i]->get_name());
+    }
+  }
+  EXPECT_EQ(snapshot.get_sequence(), 4u);
+}
+
+TEST(DrawSnapshotTest, ReaderGetsTheLastFramePublished) {
+  csci3081::DrawSnapshot snapshot;
+  EXPECT_FALSE(snapshot.Acquire());
+  for (int f = 1; f <= 5; f++) {
+    snapshot.get_back()->game_status = f;
+    snapshot.Publish();
+  }
+  ASSERT_TRUE(snapshot.Acquire());
+  EXPECT_EQ(snapshot.get_front().game_status, 5);
+  EXPECT_FALSE(snapshot.Acquire())
+    << "\nFAIL no frame was published since the last one acquired";
+  EXPECT_EQ(snapshot.get_front().game_status, 5);
+
+  // The frame being read is never the one being written
+  snapshot.get_back()->game_status = 6;
+  EXPECT_EQ(snapshot.get_front().game_status, 5);
+  snapshot.Publish();
+  ASSERT_TRUE(snapshot.Acquire());
+  EXPECT_EQ(snapshot.get_front().game_status, 6);
+}
+
+TEST(DrawSnapshotTest, TilesHoldTheRecordsCenteredInThem) {
+  csci3081::arena_params params;
+  params.n_robots = 40;
+  params.seed = 9;
+  csci3081::Arena arena(&params);
+  arena.set_draw_tile_size(100);
+  arena.UpdateEntitiesTimestep();
+  csci3081::DrawSnapshot &snapshot = arena.get_draw_snapshot();
+  ASSERT_TRUE(snapshot.Acquire());
+  const csci3081::draw_frame &frame = snapshot.get_front();
+  EXPECT_EQ(frame.tile_cols, 11);  // 1024 / 100, rounded up
+  EXPECT_EQ(frame.tile_rows, 8);
+  ASSERT_EQ(frame.tiles.size(), 88u);
+
+  std::vector<int> seen(frame.records.size(), 0);
+  for (size_t t = 0; t < frame.tiles.size(); t++) {
+    const csci3081::draw_tile &tile = frame.tiles[t];
+    int col = static_cast<int>(t) % frame.tile_cols;
+    int row = static_cast<int>(t) / frame.tile_cols;
+    unsigned red = 0;
+    for (uint32_t k = tile.begin; k < tile.begin + tile.count; k++) {
+      const csci3081::draw_record &record = frame.records[frame.tile_order[k]];
+      seen[frame.tile_order[k]]++;
+      // records past the arena's edges are in the tiles along them
+      EXPECT_TRUE(col == 0 || record.x >= 100 * col);
+      EXPECT_TRUE(col == frame.tile_cols - 1 || record.x < 100 * (col + 1));
+      EXPECT_TRUE(row == 0 || record.y >= 100 * row);
+      EXPECT_TRUE(row == frame.tile_rows - 1 || record.y < 100 * (row + 1));
+      EXPECT_LE(record.radius, frame.max_radius);
+      red += record.r;
+    }
+    if (tile.count > 0) {
+      EXPECT_EQ(tile.r, red / tile.count);
+    }
+  }
+  for (size_t i = 0; i < seen.size(); i++) {
+    EXPECT_EQ(seen[i], 1) << "record " << i;
+  }
+
+  arena.set_draw_tile_size(0);
+  arena.UpdateEntitiesTimestep();
+  ASSERT_TRUE(snapshot.Acquire());
+  EXPECT_TRUE(snapshot.get_front().tiles.empty());
+}
+
+#endif /* DRAW_SNAPSHOT_TESTS */
@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <vector>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/entity_pool.h"
+
+#ifdef ENTITY_POOL_TESTS
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+TEST(EntityPoolTest, HandlesStayValidUntilDestroyed) {
+  csci3081::EntityPool<int> pool(4);
+  std::vector<csci3081::EntityPool<int>::Handle> handles;
+  std::vector<int *> addresses;
+  for (int i = 0; i < 10; i++) {
+    handles.push_back(pool.Create(i));
+    addresses.push_back(pool.Get(handles.back()));
+  }
+  EXPECT_EQ(pool.size(), 10u);
+  EXPECT_EQ(pool.capacity(), 12u);
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(pool.Get(handles[i]), addresses[i])
+      << "\nFAIL entities should not move when the pool grows";
+    EXPECT_EQ(*pool.Get(handles[i]), i);
+  }
+
+  pool.Destroy(handles[3]);
+  EXPECT_EQ(pool.Get(handles[3]), nullptr)
+    << "\nFAIL the handle of a destroyed entity should be stale";
+  csci3081::EntityPool<int>::Handle reused = pool.Create(42);
+  EXPECT_EQ(pool.Get(reused), addresses[3]) << "\nFAIL the slot is reused";
+  EXPECT_EQ(pool.Get(handles[3]), nullptr);
+  EXPECT_EQ(pool.size(), 10u);
+}
+
+TEST(EntityPoolTest, ShrinkFreesTheEmptyTrailingSlabs) {
+  csci3081::EntityPool<int> pool(4);
+  std::vector<csci3081::EntityPool<int>::Handle> handles;
+  for (int i = 0; i < 10; i++) {
+    handles.push_back(pool.Create(i));
+  }
+  for (int i = 9; i >= 3; i--) {
+    pool.Destroy(handles[i]);
+  }
+  pool.Shrink();
+  EXPECT_EQ(pool.capacity(), 4u)
+    << "\nFAIL the slabs with no live entity should be freed";
+  EXPECT_EQ(*pool.Get(handles[2]), 2);
+
+  // The one free slot of the first slab is used before a new slab is grown
+  EXPECT_EQ(pool.Create(3).index, 3u);
+  for (int i = 4; i < 10; i++) {
+    pool.Create(i);
+  }
+  EXPECT_EQ(pool.capacity(), 12u);
+  for (int i = 3; i < 10; i++) {
+    EXPECT_EQ(pool.Get(handles[i]), nullptr)
+      << "\nFAIL a regrown slot should not revive an old handle";
+  }
+}
+
+TEST(EntityPoolTest, ArenaIsNotCappedAtTenEntities) {
+  csci3081::arena_params params;
+  params.n_robots = 300;
+  params.n_lights = 40;
+  params.seed = 3;
+  csci3081::Arena arena(&params);
+  EXPECT_EQ(arena.get_entities().size(), 300u + 40u + params.n_food);
+  for (int t = 0; t < 5; t++) {
+    arena.UpdateEntitiesTimestep();
+  }
+}
+
+#endif /* ENTITY_POOL_TESTS */
@@ -2,14 +2,18 @@
  * Includes
  ******************************************************************************/
 #include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
 #include "src/arena.h"
 #include "src/arena_params.h"
+#include "src/differential_drive_kernel.h"
 #include "src/entity_type.h"
 #include "src/motion_handler_explore.h"
 #include "src/motion_handler_fear.h"
 #include "src/motion_behavior.h"
 #include "src/motion_behavior_differential.h"
 #include "src/robot.h"
+#include "src/robot_policy.h"
 #include "src/robot_type.h"
 #include "src/params.h"
 #include "src/motion_handler.h"
@@ -352,4 +356,108 @@ TEST_F(MotionHandlerTest,ExplorerWheelFunctionalTest) {
 
 }
 
+/***************Differential Drive Kernel**************************************/
+TEST_F(MotionHandlerTest, DifferentialKernelMatchesIccModel) {
+  // The batched kernel against the ICC and straight line formulas, for an
+  // odd number of entities so that the padded block is checked too
+  std::vector<double> left, right, x, y, theta;
+  for (int i = 0; i < 11; i++) {
+    left.push_back(i % 4 == 0 ? 3.0 : 0.7 * i - 2);
+    right.push_back(i % 4 == 0 ? 3.0 : 5 - 0.9 * i);
+    x.push_back(100 + 13 * i);
+    y.push_back(400 - 29 * i);
+    theta.push_back(-720 + 150 * i);
+  }
+  std::vector<double> new_x = x, new_y = y, new_theta = theta;
+  csci3081::IntegrateDifferentialDrive(x.size(), 1, left.data(), right.data(),
+    new_x.data(), new_y.data(), new_theta.data());
+
+  for (size_t i = 0; i < x.size(); i++) {
+    double heading = csci3081::deg2rad(theta[i]);
+    double expected_x = x[i] + std::cos(heading) * left[i];
+    double expected_y = y[i] + std::sin(heading) * left[i];
+    double expected_theta = theta[i];
+    if (left[i] != right[i]) {
+      double w = (left[i] - right[i]) / 0.5;
+      double r = 0.25 * (left[i] + right[i]) / (left[i] - right[i]);
+      double icc_x = x[i] - r * std::sin(heading);
+      double icc_y = y[i] + r * std::cos(heading);
+      expected_x = (x[i] - icc_x) * std::cos(w) -
+        (y[i] - icc_y) * std::sin(w) + icc_x;
+      expected_y = (x[i] - icc_x) * std::sin(w) +
+        (y[i] - icc_y) * std::cos(w) + icc_y;
+      expected_theta = theta[i] + w;
+    }
+    EXPECT_NEAR(new_x[i], expected_x, 1e-9) << "\nFAIL x of entity " << i;
+    EXPECT_NEAR(new_y[i], expected_y, 1e-9) << "\nFAIL y of entity " << i;
+    EXPECT_NEAR(new_theta[i], expected_theta, 1e-9)
+      << "\nFAIL theta of entity " << i;
+  }
+}
+
+/***************Controller Kernels*******************************************/
+TEST_F(MotionHandlerTest, ControllerKernelsGiveTheHandlerSpeeds) {
+  // Each (behaviour, hunger band) kernel, and the motion handler of that
+  // behaviour, give the speeds of the original clamped formulas: fear
+  // 10 * light / 1000, explore 10 * (1 - crossed light / 1000), crossed
+  // 10 * food / 1000 when starving, mixed 0.6 / 0.4 (fear) or 0.5 / 0.5
+  // (explore) when hungry, each clamped to [-10, 10]
+  const double light_l[] = {200, 1100, 0};
+  const double light_r[] = {900, 0, 1100};
+  const double food_l[] = {300, 1200, 0};
+  const double food_r[] = {800, 50, 1200};
+  const double max_speed[] = {10, 10, 10};
+  const int hungry_levels[] = {0, HUNGRY + 1, STARVE};
+  // expected [band][robot][left, right]
+  const double fear[3][3][2] = {
+    {{2, 9}, {10, 0}, {0, 10}},
+    {{4.4, 6.6}, {6.2, 4}, {4, 6}},
+    {{8, 3}, {0.5, 10}, {10, 0}}};
+  const double explore[3][3][2] = {
+    {{1, 8}, {10, -1}, {-1, 10}},
+    {{4.5, 5.5}, {5.25, 4.5}, {4.5, 5}},
+    {{8, 3}, {0.5, 10}, {10, 0}}};
+
+  double left[3], right[3];
+  csci3081::controller_batch batch;
+  batch.light_left = light_l;
+  batch.light_right = light_r;
+  batch.food_left = food_l;
+  batch.food_right = food_r;
+  batch.max_speed = max_speed;
+  batch.vel_left = left;
+  batch.vel_right = right;
+  for (int b = 0; b < 3; b++) {
+    csci3081::HungerBand band = csci3081::GetHungerBand(hungry_levels[b],
+      true);
+    csci3081::ControllerKernelFor(csci3081::kFear, band)(3, batch);
+    for (int i = 0; i < 3; i++) {
+      EXPECT_DOUBLE_EQ(left[i], fear[b][i][0])
+        << "\nFAIL fear kernel, band " << band << ", robot " << i;
+      EXPECT_DOUBLE_EQ(right[i], fear[b][i][1])
+        << "\nFAIL fear kernel, band " << band << ", robot " << i;
+      motion_handler_fear->UpdateVelocity(light_l[i], light_r[i], food_l[i],
+        food_r[i], hungry_levels[b], true);
+      EXPECT_DOUBLE_EQ(motion_handler_fear->get_left_velocity(),
+        fear[b][i][0]) << "\nFAIL fear handler, band " << band;
+      EXPECT_DOUBLE_EQ(motion_handler_fear->get_right_velocity(),
+        fear[b][i][1]) << "\nFAIL fear handler, band " << band;
+    }
+    csci3081::ControllerKernelFor(csci3081::kExplorer, band)(3, batch);
+    for (int i = 0; i < 3; i++) {
+      EXPECT_DOUBLE_EQ(left[i], explore[b][i][0])
+        << "\nFAIL explore kernel, band " << band << ", robot " << i;
+      EXPECT_DOUBLE_EQ(right[i], explore[b][i][1])
+        << "\nFAIL explore kernel, band " << band << ", robot " << i;
+      motion_handler_explore->UpdateVelocity(light_l[i], light_r[i],
+        food_l[i], food_r[i], hungry_levels[b], true);
+      EXPECT_DOUBLE_EQ(motion_handler_explore->get_left_velocity(),
+        explore[b][i][0]) << "\nFAIL explore handler, band " << band;
+      EXPECT_DOUBLE_EQ(motion_handler_explore->get_right_velocity(),
+        explore[b][i][1]) << "\nFAIL explore handler, band " << band;
+    }
+  }
+  EXPECT_EQ(csci3081::GetHungerBand(STARVE, false), csci3081::kSated);
+}
+
 #endif /* MOTION_HANDLER_TESTS */
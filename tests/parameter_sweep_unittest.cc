@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/parameter_sweep.h"
+
+#ifdef PARAMETER_SWEEP_TESTS
+
+/******************************************************
+* TEST FEATURE SetUp
+*******************************************************/
+class ParameterSweepTest : public ::testing::Test {
+
+protected:
+  virtual void SetUp() {
+    grid.n_robots = {3, 6};
+    grid.n_lights = {2};
+    grid.food_on = {true, false};
+  }
+
+  // Run the sweep on n_workers threads and return its JSON lines, sorted and
+  // without the timing
+  std::vector<std::string> RunSweep(size_t n_workers) {
+    csci3081::ParameterSweep sweep;
+    sweep.AddGrid(grid, csci3081::arena_params());
+    sweep.set_replicates(2);
+    sweep.set_max_ticks(300);
+    std::ostringstream out;
+    csci3081::SweepWriter writer(&out, csci3081::SweepWriter::kJson);
+    sweep.Run(n_workers, &writer);
+
+    std::vector<std::string> lines;
+    std::istringstream in(out.str());
+    std::string line;
+    while (std::getline(in, line)) {
+      lines.push_back(line.substr(0, line.find(",\"seconds\"")));
+    }
+    std::sort(lines.begin(), lines.end());
+    return lines;
+  }
+
+  csci3081::sweep_grid grid;
+};
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+TEST_F(ParameterSweepTest, SameSeedSamePlacement) {
+  csci3081::arena_params params;
+  params.seed = 42;
+  csci3081::Arena first(&params);
+  csci3081::Arena second(&params);
+  std::vector<csci3081::ArenaEntity *> a = first.get_entities();
+  std::vector<csci3081::ArenaEntity *> b = second.get_entities();
+  ASSERT_EQ(a.size(), b.size());
+  for (size_t i = 0; i < a.size(); i++) {
+    EXPECT_EQ(a[i]->get_pose().x, b[i]->get_pose().x)
+      << "\nFAIL x differs for entity " << i;
+    EXPECT_EQ(a[i]->get_pose().y, b[i]->get_pose().y)
+      << "\nFAIL y differs for entity " << i;
+    EXPECT_EQ(a[i]->get_radius(), b[i]->get_radius())
+      << "\nFAIL radius differs for entity " << i;
+  }
+}
+
+TEST_F(ParameterSweepTest, ResultsIndependentOfWorkers) {
+  std::vector<std::string> single = RunSweep(1);
+  std::vector<std::string> parallel = RunSweep(3);
+  // 4 parameter sets, 2 replicates each
+  EXPECT_EQ(single.size(), 8u) << "\nFAIL every run should be reported once";
+  EXPECT_EQ(single, parallel)
+    << "\nFAIL results should not depend on the number of workers";
+}
+
+#endif /* PARAMETER_SWEEP_TESTS */
@@ -0,0 +1,62 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <cmath>
+#include "src/params.h"
+#include "src/response_table.h"
+#include "src/sensor.h"
+
+#ifdef RESPONSE_TABLE_TESTS
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+TEST(ResponseTableTest, InterpolationWithinErrorBound) {
+  // The light sensitivities of the slider, and the food sensitivity
+  for (double sensitivity : {1.001, 1.081, 1.2, FOOD_SENSITIVITY}) {
+    csci3081::ResponseTable table;
+    table.Build(sensitivity, 1280);
+    EXPECT_LE(table.get_max_error(), RESPONSE_TABLE_TOLERANCE);
+    EXPECT_GE(table.get_range(), std::min(1280.0,
+      csci3081::Sensor::CutoffDistance(sensitivity, RESPONSE_TABLE_FLOOR)));
+
+    // Off the tabulated distances, where the error is largest
+    double worst = 0;
+    for (double d = 0; d <= table.get_range(); d += table.get_step() * 0.37) {
+      double exact = SENSOR_GAIN / std::pow(sensitivity, d);
+      worst = std::max(worst, std::fabs(table.Response(d) - exact) / exact);
+    }
+    EXPECT_LE(worst, table.get_max_error() * (1 + 1e-6) + 1e-12)
+      << "sensitivity " << sensitivity;
+
+    double past = table.get_range() + 1.5 * table.get_step();
+    EXPECT_EQ(0, table.Response(past));
+    EXPECT_EQ(0, table.Response(1e12));
+  }
+}
+
+TEST(ResponseTableTest, TableReadingsMatchExactReadings) {
+  csci3081::ResponseTable table;
+  table.Build(1.081, 1280);
+  double sensor_x[] = {0, 100, 500, 990};
+  double sensor_y[] = {0, 50, 400, 700};
+  double source_x[] = {20, 480, 900};
+  double source_y[] = {10, 380, 30};
+  double source_radius[] = {30, 20, 10};
+  double readings[] = {0, 0, 0, 0};
+  csci3081::AccumulateTableReadings(table, 4, sensor_x, sensor_y, 3, source_x,
+    source_y, source_radius, 1e9, readings);
+  for (int i = 0; i < 4; i++) {
+    double exact = 0;
+    for (int j = 0; j < 3; j++) {
+      exact = csci3081::Sensor::AddContribution(exact, 1.081,
+        csci3081::Sensor::DistanceToSource(sensor_x[i], sensor_y[i],
+          source_x[j], source_y[j], source_radius[j]));
+    }
+    EXPECT_NEAR(readings[i], exact,
+      exact * RESPONSE_TABLE_TOLERANCE + 3 * RESPONSE_TABLE_FLOOR);
+  }
+}
+
+#endif /* RESPONSE_TABLE_TESTS */
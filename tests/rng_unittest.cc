@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/rng.h"
+
+#ifdef RNG_TESTS
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Known answers from the Random123 distribution (kat_vectors, philox4x32 10)
+TEST(RngTest, PhiloxKnownAnswers) {
+  const uint32_t counters[3][4] = {
+    {0, 0, 0, 0},
+    {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+    {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}};
+  const uint32_t keys[3][2] = {
+    {0, 0},
+    {0xffffffff, 0xffffffff},
+    {0xa4093822, 0x299f31d0}};
+  const uint32_t expected[3][4] = {
+    {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+    {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+    {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}};
+  for (int i = 0; i < 3; i++) {
+    uint32_t out[4];
+    csci3081::Philox4x32(counters[i], keys[i], out);
+    for (int w = 0; w < 4; w++) {
+      EXPECT_EQ(out[w], expected[i][w])
+        << "\nFAIL word " << w << " of known answer " << i;
+    }
+  }
+}
+
+TEST(RngTest, StreamsAreIndependent) {
+  csci3081::Rng rng(7);
+  csci3081::RandomStream first = rng.Stream(csci3081::kRobot, 1, 0);
+  csci3081::RandomStream again = rng.Stream(csci3081::kRobot, 1, 0);
+  csci3081::RandomStream other = rng.Stream(csci3081::kRobot, 2, 0);
+  csci3081::RandomStream later = rng.Stream(csci3081::kRobot, 1, 1);
+  // Drawing from other streams in between does not change a stream
+  std::vector<uint32_t> drawn;
+  for (int i = 0; i < 10; i++) {
+    drawn.push_back(first.NextUint());
+    other.NextUint();
+  }
+  int same_other = 0;
+  int same_later = 0;
+  csci3081::RandomStream other_again = rng.Stream(csci3081::kRobot, 2, 0);
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(again.NextUint(), drawn[i])
+      << "\nFAIL a stream should only depend on its key";
+    same_other += (other_again.NextUint() == drawn[i]);
+    same_later += (later.NextUint() == drawn[i]);
+  }
+  EXPECT_LT(same_other, 2) << "\nFAIL the streams of two ids should differ";
+  EXPECT_LT(same_later, 2) << "\nFAIL the streams of two epochs should differ";
+}
+
+TEST(RngTest, ResetIsReproducible) {
+  csci3081::arena_params params;
+  params.seed = 42;
+  csci3081::Arena first(&params);
+  csci3081::Arena second(&params);
+  first.Reset();
+  second.Reset();
+  std::vector<csci3081::ArenaEntity *> a = first.get_entities();
+  std::vector<csci3081::ArenaEntity *> b = second.get_entities();
+  ASSERT_EQ(a.size(), b.size());
+  for (size_t i = 0; i < a.size(); i++) {
+    EXPECT_EQ(a[i]->get_pose().x, b[i]->get_pose().x)
+      << "\nFAIL x differs after reset for entity " << i;
+    EXPECT_EQ(a[i]->get_pose().y, b[i]->get_pose().y)
+      << "\nFAIL y differs after reset for entity " << i;
+    EXPECT_EQ(a[i]->get_pose().theta, b[i]->get_pose().theta)
+      << "\nFAIL heading differs after reset for entity " << i;
+  }
+}
+
+#endif /* RNG_TESTS */
@@ -4,10 +4,13 @@
  * Includes
  ******************************************************************************/
 #include <gtest/gtest.h>
+#include <limits>
+#include <vector>
 #include "src/arena.h"
 #include "src/arena_params.h"
 #include "src/communication.h"
 #include "src/entity_type.h"
+#include "src/light_sensing_kernel.h"
 #include "src/sensor_type.h"
 #include "src/robot.h"
 #include "src/params.h"
@@ -66,6 +69,29 @@ protected:
   csci3081::LightSensor * light_sensor;
 
 
+  /**
+   * The readings given by the batched kernel to 5 sensors at (x, y), with
+   * the default sensitivity and no cutoff, for lights of the fixture's
+   * radius at the given offsets from the sensors. An odd number of sensors
+   * goes through both the full and the padded blocks of the kernel.
+   */
+  std::vector<double> KernelReadings(double x, double y,
+      const std::vector<csci3081::Pose> &offsets) {
+    std::vector<double> sensor_x(5, x), sensor_y(5, y), sense(5, 1.08);
+    std::vector<double> light_x, light_y, light_r;
+    for (const csci3081::Pose &offset : offsets) {
+      light_x.push_back(x + offset.x);
+      light_y.push_back(y + offset.y);
+      light_r.push_back(radius);
+    }
+    std::vector<double> readings(5, 0);
+    csci3081::AccumulateLightReadings(sensor_x.size(), sensor_x.data(),
+      sensor_y.data(), sense.data(), light_x.size(), light_x.data(),
+      light_y.data(), light_r.data(), std::numeric_limits<double>::infinity(),
+      readings.data());
+    return readings;
+  }
+
   double radius;
   double sensor_l_x;
   double sensor_l_y;
@@ -556,5 +582,133 @@ TEST_F(SensorLightTest, SensorPosition) {
       << "\nFAIL right sensor reading is too large while lights very far away";
  }
 
+/***************Sensing Cutoff*************************************************/
+ TEST_F(SensorLightTest, CutoffDropsOnlyNegligibleLights) {
+   // Test that a sensing cutoff ignores far lights but keeps close ones
+   robot->set_radius(radius);
+   robot->set_position(0,0);
+   robot->set_heading(0);
+   double cutoff = csci3081::Sensor::CutoffDistance(1.08, 0.01);
+   robot->set_sensing_cutoff(cutoff, cutoff);
+
+   robot->reset_sensor_reading();
+   light1->set_position(sensor_l_x+300, sensor_l_y+400);
+   robot->LightNotify(light1->get_pose(),radius);
+   EXPECT_EQ(robot->get_light_sensor_reading(LEFT_SENSOR),0)
+   << "\nFAIL light beyond the cutoff should be ignored";
+
+   light1->set_position(sensor_l_x+10, sensor_l_y+24);
+   robot->LightNotify(light1->get_pose(),radius);
+   EXPECT_LT(robot->get_light_sensor_reading(LEFT_SENSOR),756.5)
+   << "\nFAIL left sensor reading too large";
+   EXPECT_GT(robot->get_light_sensor_reading(LEFT_SENSOR),756.1)
+   << "\nFAIL left sensor reading too small";
+ }
+
+TEST_F(SensorLightTest, FoodRadiusCapsTheFoodCutoff) {
+  // By default only the epsilon gives the food cutoff, which is then larger
+  // than the arena; a food sensing radius keeps the far food out
+  csci3081::arena_params params;
+  params.sensing_mode = csci3081::kSenseCutoff;
+  csci3081::Arena uncapped(&params);
+  EXPECT_EQ(uncapped.get_food_cutoff(), csci3081::Sensor::CutoffDistance(
+    FOOD_SENSITIVITY, params.sensing_epsilon));
+  EXPECT_GT(uncapped.get_food_cutoff(), ARENA_X_DIM);
+
+  params.food_sensing_radius = 256;
+  csci3081::Arena capped(&params);
+  EXPECT_EQ(capped.get_food_cutoff(), 256);
+  EXPECT_EQ(capped.get_light_cutoff(), uncapped.get_light_cutoff());
+}
+
+/***************Batched Kernel*************************************************/
+ TEST_F(SensorLightTest, KernelMatchesScalarPath) {
+   // Test that the batched kernel gives the readings of CalculateSensorReading
+   // within the documented tolerance, for an odd number of sensors
+   std::vector<double> light_x, light_y, light_r;
+   for (int j = 0; j < 9; j++) {
+     light_x.push_back(sensor_l_x + (j * 37) % 200 - 100);
+     light_y.push_back(sensor_l_y + (j * 53) % 160 - 80);
+     light_r.push_back(5 + j * 3);
+   }
+   std::vector<double> x, y, sense, readings;
+   for (int i = 0; i < 7; i++) {
+     x.push_back(sensor_l_x + i * 11);
+     y.push_back(sensor_l_y - i * 7);
+     sense.push_back(1.02 + 0.02 * i);
+     readings.push_back(i);
+   }
+   csci3081::AccumulateLightReadings(x.size(), x.data(), y.data(),
+     sense.data(), light_x.size(), light_x.data(), light_y.data(),
+     light_r.data(), 150, readings.data());
+
+   for (size_t i = 0; i < x.size(); i++) {
+     csci3081::LightSensor sensor;
+     sensor.set_sensitivity(sense[i]);
+     sensor.set_cutoff_distance(150);
+     sensor.set_reading(i);
+     for (size_t j = 0; j < light_x.size(); j++) {
+       sensor.CalculateSensorReading(csci3081::Pose(light_x[j], light_y[j]),
+         light_r[j], csci3081::Pose(x[i], y[i]));
+     }
+     EXPECT_NEAR(readings[i], sensor.get_reading(),
+       LIGHT_KERNEL_TOLERANCE * sensor.get_reading())
+     << "\nFAIL kernel reading differs for sensor " << i;
+   }
+
+   // Same close light as LeftSensorReadingOnOneCloseLight
+   double reading = 0;
+   double light_sx = sensor_l_x + 10;
+   double light_sy = sensor_l_y + 24;
+   double sensitivity = 1.08;
+   csci3081::AccumulateLightReadings(1, &sensor_l_x, &sensor_l_y,
+     &sensitivity, 1, &light_sx, &light_sy, &radius, 1000, &reading);
+   EXPECT_LT(reading, 756.5) << "\nFAIL kernel reading too large";
+   EXPECT_GT(reading, 756.1) << "\nFAIL kernel reading too small";
+ }
+
+TEST_F(SensorLightTest, KernelMeetsTheSensorFixtures) {
+  // Test that the batched kernel gives the readings expected above of one
+  // far light, one close light, four lights, four close lights, a collision
+  // and four very far lights, for the left and the right sensor
+  struct fixture {
+    const char *name;
+    std::vector<csci3081::Pose> offsets;
+    double low, high;  // the reading is within (low, high), or is high
+  };
+  std::vector<fixture> fixtures = {
+    {"one far light", {{45, 108}}, 0.68, 0.69},
+    {"one close light", {{10, 24}}, 756.1, 756.5},
+    {"four lights", {{30, 40}, {-30, -40}, {25, 60}, {-25, -60}}, 0, 330},
+    {"four nearer lights", {{25, 30}, {-25, -30}, {25, 60}, {-25, -60}},
+      330, 660},
+    {"four close lights", {{20, 40}, {-20, -40}, {20, 40}, {-20, -40}},
+      660, 1000},
+    {"saturation", {{12, 16}, {-12, -16}, {10, 24}, {-10, -24}}, 1000, 1000},
+    {"collision", {{0, 0}, {-30, -40}, {25, 60}, {-25, -60}}, 1000, 1000},
+    {"four very far lights",
+      {{300, 400}, {-300, -400}, {250, 600}, {-250, -600}}, 0, 2.2e-13},
+  };
+  for (const fixture &f : fixtures) {
+    for (const csci3081::Pose &sensor : {csci3081::Pose(sensor_l_x, sensor_l_y),
+        csci3081::Pose(sensor_r_x, sensor_r_y)}) {
+      std::vector<double> readings = KernelReadings(sensor.x, sensor.y,
+        f.offsets);
+      for (double reading : readings) {
+        if (f.low < f.high) {
+          EXPECT_GT(reading, f.low) << "\nFAIL kernel reading too small, "
+            << f.name;
+          EXPECT_LT(reading, f.high) << "\nFAIL kernel reading too large, "
+            << f.name;
+        } else {
+          EXPECT_EQ(reading, f.high) << "\nFAIL kernel reading not "
+            << f.high << ", " << f.name;
+        }
+        EXPECT_EQ(reading, readings[0])
+          << "\nFAIL kernel readings differ within a batch, " << f.name;
+      }
+    }
+  }
+}
 
 #endif /*SENSORLIGHT_TESTS */
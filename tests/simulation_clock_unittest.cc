@@ -0,0 +1,44 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include "src/simulation_clock.h"
+
+#ifdef SIMULATION_CLOCK_TESTS
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+TEST(SimulationClockTest, RunsOneTickPerStep) {
+  csci3081::SimulationClock clock(0.05, 1.0);
+  clock.RecordTicks(1, 0.001);
+  int ticks = 0;
+  // 2 seconds of 60 Hz frames
+  for (int frame = 0; frame < 120; frame++) {
+    ticks += clock.TicksDue(1.0 / 60);
+  }
+  EXPECT_NEAR(ticks, 40, 1) << "\nFAIL 20 ticks per second expected";
+
+  clock.set_multiplier(4);
+  ticks = 0;
+  for (int frame = 0; frame < 120; frame++) {
+    ticks += clock.TicksDue(1.0 / 60);
+  }
+  EXPECT_NEAR(ticks, 160, 1) << "\nFAIL the multiplier should scale the rate";
+}
+
+TEST(SimulationClockTest, StaysWithinFrameBudget) {
+  csci3081::SimulationClock clock(0.05, 0.01);
+  clock.RecordTicks(10, 0.01);
+  EXPECT_EQ(clock.get_max_ticks(), 10);
+
+  // A long frame does not make the next frames catch up
+  EXPECT_EQ(clock.TicksDue(10.0), 10);
+  EXPECT_EQ(clock.TicksDue(0.01), 0);
+
+  clock.set_fast_forward(true);
+  EXPECT_EQ(clock.TicksDue(0.0), 10)
+    << "\nFAIL fast forward should fill the frame budget";
+}
+
+#endif /* SIMULATION_CLOCK_TESTS */
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/simulation_thread.h"
+#include "src/spsc_queue.h"
+
+#ifdef SIMULATION_THREAD_TESTS
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+TEST(SpscQueueTest, ValuesArriveInOrderAcrossThreads) {
+  csci3081::SpscQueue<int, 4> queue;
+  int value = 0;
+  EXPECT_FALSE(queue.Pop(&value));
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(queue.Push(i));
+  }
+  EXPECT_FALSE(queue.Push(4)) << "\nFAIL the queue holds 4 values";
+  for (int i = 0; i < 4; i++) {
+    ASSERT_TRUE(queue.Pop(&value));
+    EXPECT_EQ(value, i);
+  }
+
+  const int kValues = 100000;
+  std::thread producer([&queue] {
+    for (int i = 0; i < kValues; i++) {
+      while (!queue.Push(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  int expected = 0;
+  while (expected < kValues) {
+    if (queue.Pop(&value)) {
+      ASSERT_EQ(value, expected);
+      expected++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_FALSE(queue.Pop(&value));
+}
+
+/*
+ * Wait for the simulation thread to publish a frame that pred holds for, for
+ * at most 10 seconds.
+ */
+template <class Pred>
+static bool WaitForFrame(csci3081::DrawSnapshot *snapshot, Pred pred) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (std::chrono::steady_clock::now() < deadline) {
+    if (snapshot->Acquire() && pred(snapshot->get_front())) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return false;
+}
+
+TEST(SimulationThreadTest, RunsTheArenaAndTakesCommands) {
+  csci3081::arena_params params;
+  params.n_robots = 5;
+  params.seed = 2;
+  csci3081::SimulationThread simulation(new csci3081::Arena(&params));
+  csci3081::DrawSnapshot *snapshot = simulation.get_snapshot();
+  ASSERT_TRUE(snapshot->Acquire());
+  EXPECT_EQ(snapshot->get_front().records.size(),
+    params.n_robots + params.n_lights + params.n_food);
+
+  simulation.Start();
+  EXPECT_TRUE(simulation.is_running());
+  uint64_t published = snapshot->get_sequence();
+  simulation.Post(csci3081::kFastForwardOn);
+  simulation.Post(csci3081::kPlay);
+  EXPECT_TRUE(WaitForFrame(snapshot, [&](const csci3081::draw_frame &) {
+    return snapshot->get_sequence() > published + 10;
+  }));
+
+  // A new game reconfigures the arena, which keeps publishing to the frames
+  csci3081::simulation_command command;
+  command.com = csci3081::kNewGame;
+  auto next = std::make_shared<csci3081::arena_params>(params);
+  next->n_robots = 2;
+  next->n_lights = 1;
+  next->n_food = 0;
+  command.params = next;
+  simulation.Post(command);
+  EXPECT_TRUE(WaitForFrame(snapshot, [](const csci3081::draw_frame &frame) {
+    return frame.records.size() == 3;
+  }));
+
+  simulation.Stop();
+  EXPECT_FALSE(simulation.is_running());
+}
+
+#endif /* SIMULATION_THREAD_TESTS */
@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "src/params.h"
+#include "src/sensor.h"
+#include "src/stimulus_field.h"
+#include "src/thread_pool.h"
+
+#ifdef STIMULUS_FIELD_TESTS
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+static double ExactField(double x, double y, const std::vector<double> &sx,
+  const std::vector<double> &sy, const std::vector<double> &radius,
+  double sensitivity, double cutoff) {
+  double sum = 0;
+  for (size_t j = 0; j < sx.size(); j++) {
+    double distance = csci3081::Sensor::DistanceToSource(x, y, sx[j], sy[j],
+      radius[j]);
+    if (!(distance > cutoff)) {
+      sum += SENSOR_GAIN / std::pow(sensitivity, distance);
+    }
+  }
+  return sum;
+}
+
+TEST(StimulusFieldTest, SamplesMatchResponses) {
+  const double kSensitivity = 1.081;
+  double cutoff = csci3081::Sensor::CutoffDistance(kSensitivity,
+    SENSING_EPSILON);
+  std::vector<double> sx = {100, 400, 700}, sy = {100, 500, 200};
+  std::vector<double> radius = {20, 35, 50};
+  csci3081::StimulusField field;
+  field.Resize(1024, 768, 2);
+  field.set_response(kSensitivity, cutoff);
+  field.Update(sx.size(), sx.data(), sy.data(), radius.data(), nullptr);
+
+  // The tabulated responses at the nodes, within the bilinear error between
+  for (double x : {0.0, 150.0, 402.0, 640.0}) {
+    for (double y : {0.0, 100.0, 312.0, 766.0}) {
+      double exact = ExactField(x, y, sx, sy, radius, kSensitivity, cutoff);
+      EXPECT_NEAR(field.Sample(x, y), exact, exact * RESPONSE_TABLE_TOLERANCE)
+        << x << "," << y;
+    }
+  }
+  for (double x : {3.0, 137.3, 421.7, 700.9}) {
+    for (double y : {1.1, 97.5, 229.9, 533.3}) {
+      double exact = ExactField(x, y, sx, sy, radius, kSensitivity, cutoff);
+      EXPECT_NEAR(field.Sample(x, y), exact, exact * 0.01 + SENSING_EPSILON)
+        << x << "," << y;
+    }
+  }
+}
+
+TEST(StimulusFieldTest, UpdatingMovedSourcesMatchesRasterising) {
+  std::vector<double> sx = {100, 400, 700, 900}, sy = {100, 500, 200, 700};
+  std::vector<double> radius = {20, 35, 50, 10};
+  csci3081::ThreadPool pool(3);
+  csci3081::StimulusField updated;
+  updated.Resize(1024, 768, 4);
+  updated.set_response(1.081, 150);
+  updated.Update(sx.size(), sx.data(), sy.data(), radius.data(), &pool);
+  size_t all_tiles = updated.get_n_rasterized_tiles();
+
+  // Nothing moved
+  updated.Update(sx.size(), sx.data(), sy.data(), radius.data(), &pool);
+  EXPECT_EQ(updated.get_n_rasterized_tiles(), 0u);
+
+  sx[1] += 3.5;
+  sy[3] -= 20;
+  updated.Update(sx.size(), sx.data(), sy.data(), radius.data(), &pool);
+  EXPECT_GT(updated.get_n_rasterized_tiles(), 0u);
+  EXPECT_LT(updated.get_n_rasterized_tiles(), all_tiles);
+
+  csci3081::StimulusField fresh;
+  fresh.Resize(1024, 768, 4);
+  fresh.set_response(1.081, 150);
+  fresh.Update(sx.size(), sx.data(), sy.data(), radius.data(), nullptr);
+  for (double x = 0; x <= 1024; x += 5.3) {
+    for (double y = 0; y <= 768; y += 4.7) {
+      ASSERT_EQ(updated.Sample(x, y), fresh.Sample(x, y)) << x << "," << y;
+    }
+  }
+}
+
+#endif /* STIMULUS_FIELD_TESTS */
@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/trajectory_reader.h"
+#include "src/trajectory_recorder.h"
+
+#ifdef TRAJECTORY_TESTS
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+TEST(TrajectoryTest, RecordedTicksReadBack) {
+  std::string path = testing::TempDir() + "trajectory_unittest.bvt";
+  csci3081::arena_params params;
+  params.n_robots = 20;
+  params.seed = 5;
+  csci3081::Arena arena(&params);
+  csci3081::TrajectoryRecorder recorder(16);
+  ASSERT_TRUE(recorder.Open(path));
+  arena.set_recorder(&recorder);
+
+  // What the recording should hold, robot by robot for each tick
+  const int kTicks = 100;
+  std::vector<csci3081::Pose> poses;
+  std::vector<int> hunger;
+  for (int t = 0; t < kTicks; t++) {
+    arena.UpdateEntitiesTimestep();
+    for (auto *entity : arena.get_entities()) {
+      if (entity->get_type() == csci3081::kRobot) {
+        poses.push_back(entity->get_pose());
+        hunger.push_back(
+          static_cast<csci3081::Robot *>(entity)->get_hungry_counter());
+      }
+    }
+  }
+  arena.set_recorder(nullptr);
+  ASSERT_TRUE(recorder.Close());
+
+  csci3081::TrajectoryReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  EXPECT_EQ(reader.get_n_ticks(), static_cast<uint64_t>(kTicks));
+  ASSERT_EQ(reader.get_n_robots(), params.n_robots);
+  EXPECT_FLOAT_EQ(reader.get_radius(0),
+    arena.get_entities()[0]->get_radius());
+
+  // In order, then seeking back and forth across chunks
+  std::vector<int> ticks;
+  for (int t = 0; t < kTicks; t++) {
+    ticks.push_back(t);
+  }
+  for (int t : {77, 3, 16, 15, 99, 50, 51, 0}) {
+    ticks.push_back(t);
+  }
+  std::vector<csci3081::trajectory_sample> samples;
+  for (int t : ticks) {
+    ASSERT_TRUE(reader.ReadTick(static_cast<uint64_t>(t), &samples));
+    for (size_t i = 0; i < params.n_robots; i++) {
+      const csci3081::Pose &pose = poses[t * params.n_robots + i];
+      EXPECT_NEAR(samples[i].x, pose.x, 1e-3) << "tick " << t;
+      EXPECT_NEAR(samples[i].y, pose.y, 1e-3) << "tick " << t;
+      EXPECT_NEAR(samples[i].theta, pose.theta, 1e-2) << "tick " << t;
+      EXPECT_EQ(samples[i].hunger, hunger[t * params.n_robots + i]);
+    }
+  }
+  EXPECT_FALSE(reader.ReadTick(kTicks, &samples));
+  std::remove(path.c_str());
+}
+
+TEST(TrajectoryTest, UnfinishedRecordingIsRejected) {
+  std::string path = testing::TempDir() + "trajectory_unfinished.bvt";
+  csci3081::arena_params params;
+  params.seed = 5;
+  csci3081::Arena arena(&params);
+  csci3081::TrajectoryRecorder recorder(4);
+  ASSERT_TRUE(recorder.Open(path));
+  arena.set_recorder(&recorder);
+  for (int t = 0; t < 10; t++) {
+    arena.UpdateEntitiesTimestep();
+  }
+
+  csci3081::TrajectoryReader reader;
+  EXPECT_FALSE(reader.Open(path))
+    << "\nFAIL the index is only written when the recorder is closed";
+  recorder.Close();
+  EXPECT_TRUE(reader.Open(path));
+  EXPECT_EQ(reader.get_n_ticks(), 10u);
+  std::remove(path.c_str());
+}
+
+#endif /* TRAJECTORY_TESTS */
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "src/params.h"
+#include "src/robot_policy.h"
+#include "src/wiring.h"
+
+#ifdef WIRING_TESTS
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+TEST(WiringTest, DefaultWiringsMatchPolicies) {
+  // An odd number of robots, with readings over the whole range
+  const size_t n = 13;
+  std::vector<double> light_l, light_r, food_l, food_r, max_speed;
+  for (size_t i = 0; i < n; i++) {
+    light_l.push_back((i * 83) % (MAX_READING + 1));
+    light_r.push_back((i * 211) % (MAX_READING + 1));
+    food_l.push_back((i * 379) % (MAX_READING + 1));
+    food_r.push_back(MAX_READING - (i * 97) % (MAX_READING + 1));
+    max_speed.push_back(ROBOT_MAX_SPEED);
+  }
+  std::vector<double> left(n), right(n), wired_left(n), wired_right(n);
+  csci3081::controller_batch batch;
+  batch.light_left = light_l.data();
+  batch.light_right = light_r.data();
+  batch.food_left = food_l.data();
+  batch.food_right = food_r.data();
+  batch.max_speed = max_speed.data();
+  batch.vel_left = left.data();
+  batch.vel_right = right.data();
+
+  for (int b = 0; b < 2; b++) {
+    auto behavior = static_cast<csci3081::RobotType>(b);
+    csci3081::vehicle_wiring wiring = csci3081::DefaultWiring(behavior);
+    for (int band = 0; band < csci3081::kHungerBandCount; band++) {
+      csci3081::ControllerKernelFor(behavior,
+        static_cast<csci3081::HungerBand>(band))(n, batch);
+      std::vector<double> weights(csci3081::kWiringWeightCount * n);
+      for (size_t w = 0; w < csci3081::kWiringWeightCount; w++) {
+        for (size_t i = 0; i < n; i++) {
+          weights[w * n + i] = wiring.band[band].weight[w];
+        }
+      }
+      csci3081::ApplyWirings(n, weights.data(), light_l.data(),
+        light_r.data(), food_l.data(), food_r.data(), max_speed.data(),
+        wired_left.data(), wired_right.data());
+      for (size_t i = 0; i < n; i++) {
+        EXPECT_NEAR(wired_left[i], left[i], 1e-12)
+          << "\nFAIL behaviour " << b << " band " << band << " robot " << i;
+        EXPECT_NEAR(wired_right[i], right[i], 1e-12)
+          << "\nFAIL behaviour " << b << " band " << band << " robot " << i;
+      }
+    }
+  }
+}
+
+TEST(WiringTest, ConfigurationChangesListedWheels) {
+  csci3081::wiring_table wirings = csci3081::DefaultWirings();
+  std::istringstream config(
+    "# explorers that ignore the lights\n"
+    "\n"
+    "explorer sated left 0 0 0 0 5\n"
+    "  explorer sated right 0 0.5 0 0 -1e-3\n");
+  std::string error;
+  ASSERT_TRUE(csci3081::ReadWirings(config, &wirings, &error)) << error;
+  const csci3081::wiring_matrix &sated =
+    wirings[csci3081::kExplorer].band[csci3081::kSated];
+  EXPECT_EQ(sated.weight[csci3081::kWireBias], 5);
+  EXPECT_EQ(sated.weight[csci3081::kWiringInputCount +
+    csci3081::kWireLightRight], 0.5);
+  EXPECT_EQ(sated.weight[csci3081::kWiringInputCount +
+    csci3081::kWireBias], -1e-3);
+  // Everything else is left as it was
+  EXPECT_EQ(wirings[csci3081::kExplorer].band[csci3081::kHungry].weight[0],
+    csci3081::DefaultWiring(csci3081::kExplorer).band[1].weight[0]);
+
+  for (std::string line : {"robot sated left 0 0 0 0 0",
+                           "fear full left 0 0 0 0 0",
+                           "fear sated both 0 0 0 0 0",
+                           "fear sated left 0 0 0 0",
+                           "fear sated left 0 0 0 0 0 0"}) {
+    std::istringstream bad(line);
+    EXPECT_FALSE(csci3081::ReadWirings(bad, &wirings, &error))
+      << "\nFAIL accepted " << line;
+    EXPECT_EQ(error, line);
+  }
+}
+
+#endif /* WIRING_TESTS */